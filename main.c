@@ -1,10 +1,64 @@
 #include <parser.h>
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 int main(int argc, char **argv)
 {
-    NK_Parser *parser = NK_Parse_Create(argv[1]);
-    parser->parse(parser);
-    parser->symtab(parser);
+    NK_UInt32 flags = NK_PARSE_DEFAULT;
+    NK_Boolean stats = NK_False;
+    NK_Int i;
+
+    if (argc < 2) {
+        printf("usage: %s <elf|-> [header] [section] [segments] [symtab] [stats]\n", argv[0]);
+        return -1;
+    }
+
+    /// 预告要输出的内容，解析器据此只读取需要的部分。
+    for (i = 2; i < argc; i++) {
+        if (0 == strcmp(argv[i], "header"))
+            flags |= NK_PARSE_HEADER;
+        else if (0 == strcmp(argv[i], "section"))
+            flags |= NK_PARSE_SECTION;
+        else if (0 == strcmp(argv[i], "segments"))
+            flags |= NK_PARSE_SEGMENT;
+        else if (0 == strcmp(argv[i], "symtab"))
+            flags |= NK_PARSE_SYMTAB;
+        else if (0 == strcmp(argv[i], "stats"))
+            stats = NK_True;
+    }
+
+    /// 设置了缓存目录时使用解析缓存。
+    if (NK_Nil != getenv("NK_PARSE_CACHE_DIR")) {
+        NK_Parse_SetCacheDir(getenv("NK_PARSE_CACHE_DIR"));
+        flags |= NK_PARSE_CACHE;
+    }
+
+    /// 默认输出符号表。
+    if (0 == (flags & NK_PARSE_QUERIES))
+        flags |= NK_PARSE_SYMTAB;
+
+    NK_Parser *parser = NK_Parse_CreateEx(argv[1], flags);
+    if (NK_Nil == parser)
+        return -1;
+
+    if (0 == parser->parse(parser)) {
+        if (flags & NK_PARSE_HEADER)
+            parser->header(parser);
+        if (flags & NK_PARSE_SECTION)
+            parser->section(parser);
+        if (flags & NK_PARSE_SEGMENT)
+            parser->segments(parser);
+        if (flags & NK_PARSE_SYMTAB)
+            parser->symtab(parser);
+        if (stats) {
+            NK_ParseStats st;
+            parser->stats(parser, &st);
+            printf("major faults: %llu, minor faults: %llu, advices: %llu\n"
+                , (unsigned long long)st.MajorFaults, (unsigned long long)st.MinorFaults, (unsigned long long)st.Advices);
+        }
+    }
 
     return NK_Parse_Free(&parser);
 }
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <elf.h>
 #include <utils.h>
@@ -21,6 +22,525 @@
 
 #define TRACE(fmt, arg...) printf(fmt, ##arg)
 
+/**
+ * elf 源类型。
+ */
+typedef enum NK_ElfSource {
+
+    /// 未解析
+    NK_ELF_SRC_NONE = 0,
+    /// 只读映射
+    NK_ELF_SRC_MAP,
+    /// 整体读入堆内存
+    NK_ELF_SRC_HEAP,
+    /// 按需 pread 读取
+    NK_ELF_SRC_LAZY,
+    /// 顺序流读取，仅保留需要的区间
+    NK_ELF_SRC_STREAM,
+    /// 调用者提供的内存
+    NK_ELF_SRC_MEMORY,
+
+} NK_ElfSource;
+
+/**
+ * 延迟加载时从文件读取的一段区间，按读取顺序挂在私有句柄上。
+ */
+typedef struct NK_ElfRegion {
+
+    struct NK_ElfRegion *Next;
+
+    /// 区间在文件中的偏移
+    NK_Size64 Offset;
+
+    /// 区间长度
+    NK_Size64 Size;
+
+    /// 区间数据，通常紧跟在区间结构之后，命中解析缓存时指向缓存文件映射
+    NK_PByte Data;
+
+} NK_ElfRegion;
+
+/**
+ * 文件区间。
+ */
+typedef struct NK_ElfRange {
+
+    NK_Size64 Offset;
+
+    NK_Size64 Size;
+
+} NK_ElfRange;
+
+/**
+ * 延迟加载时段表之前预读的窗口，用于顺带读到段表字符串表。
+ * 窗口取 段数 x 平均段名长度，且不小于一页。
+ */
+#define NK_ELF_SHSTRTAB_AHEAD   (4 * 1024)
+#define NK_ELF_SHSTRTAB_AVG     (32)
+
+/**
+ * 流式读取时的数据块大小。
+ */
+#define NK_ELF_STREAM_CHUNK (64 * 1024)
+
+/**
+ * 解析缓存目录，为空时不使用缓存。
+ */
+static NK_Char Elf_CacheDir[256] = {""};
+
+/**
+ * 与类别无关的 ELF 头，解析时按文件类别解码一次。
+ */
+typedef struct NK_ElfHeader {
+
+    NK_Byte Ident[EI_NIDENT];
+
+    NK_UInt16 Type;
+
+    NK_UInt16 Machine;
+
+    NK_UInt32 Version;
+
+    NK_UInt64 Entry;
+
+    /// 程序头表偏移
+    NK_UInt64 Phoff;
+
+    /// 段表偏移
+    NK_UInt64 Shoff;
+
+    NK_UInt32 Flags;
+
+    NK_UInt16 Ehsize;
+
+    NK_UInt16 Phentsize;
+
+    /// 程序头数，已解析扩展编号
+    NK_UInt32 Phnum;
+
+    NK_UInt16 Shentsize;
+
+    /// 段数，已解析扩展编号
+    NK_UInt32 Shnum;
+
+    /// 段表字符串表索引，已解析扩展编号
+    NK_UInt32 Shstrndx;
+
+} NK_ElfHeader;
+
+/**
+ * 与类别无关的段表项，供加载、缓存等非热点路径使用。
+ */
+typedef struct NK_ElfShdr {
+
+    NK_UInt32 Name;
+
+    NK_UInt32 Type;
+
+    NK_UInt64 Flags;
+
+    NK_UInt64 Addr;
+
+    NK_UInt64 Offset;
+
+    NK_UInt64 Size;
+
+    NK_UInt32 Link;
+
+    NK_UInt32 Info;
+
+    NK_UInt64 Addralign;
+
+    NK_UInt64 Entsize;
+
+} NK_ElfShdr;
+
+/**
+ * 与类别无关的程序头表项。
+ */
+typedef struct NK_ElfPhdr {
+
+    NK_UInt32 Type;
+
+    NK_UInt32 Flags;
+
+    NK_UInt64 Offset;
+
+    NK_UInt64 Vaddr;
+
+    NK_UInt64 Paddr;
+
+    NK_UInt64 Filesz;
+
+    NK_UInt64 Memsz;
+
+    NK_UInt64 Align;
+
+} NK_ElfPhdr;
+
+/**
+ * 排序键，段到程序段的映射按文件偏移或地址排序后扫描。
+ */
+typedef struct NK_ElfKey {
+
+    NK_UInt64 Key;
+
+    /// 段索引，或批量按地址查找时的输入位置（与地址数同为 NK_Size）
+    NK_Size Index;
+
+} NK_ElfKey;
+
+/**
+ * 规范化的段描述，解析时由段表构建一次，各方法直接复用，字段宽度与类别无关。\n
+ * 不含指针，可原样写入解析缓存，命中时直接使用映射中的段描述表；发布后只读。
+ */
+typedef struct NK_ElfSection {
+
+    /// 段名在 @ref NK_PrivatedParser::Shstrtab 中的偏移，已校验以 '\0' 结尾，见 @ref Elf_section_name()
+    NK_UInt32 Name;
+
+    /// 段名长度，无效段名为 0
+    NK_Size NameLen;
+
+    NK_UInt32 Type;
+
+    NK_UInt64 Flags;
+
+    NK_UInt64 Addr;
+
+    NK_UInt64 Offset;
+
+    NK_UInt64 Size;
+
+    NK_UInt32 Link;
+
+    NK_UInt32 Info;
+
+    NK_UInt64 Addralign;
+
+    NK_UInt64 Entsize;
+
+    /// 符号表关联的 SHT_SYMTAB_SHNDX 段索引，没有时为 0
+    NK_UInt32 Xindex;
+
+    /// 校验结果，NK_ELF_CHECK_*
+    NK_UInt32 Checks;
+
+} NK_ElfSection;
+
+/**
+ * 解析缓存文件格式，整个文件只读映射后直接使用，各部分以缓存文件内的偏移引用，8 字节对齐：\n
+ *
+ *  +-------------------+---------------------------+--------+--------------------------+--------------+
+ *  | NK_ElfCacheHeader | NK_ElfSection x Shnum + 1 | 段名池 | NK_ElfCacheEntry x Count | 已转换的区间 |
+ *  +-------------------+---------------------------+--------+--------------------------+--------------+
+ *
+ * 缓存文件以源文件 (dev, inode) 命名，\n
+ * 长度、修改时间与 ELF 头散列不一致时视为失效并被覆盖。\n
+ * 缓存的是解码结果：ELF 头、段描述表（含符号表的扫描结果）与段名；\n
+ * 与本机字节序不同的文件另存已转换为本机字节序的段表、符号表、扩展段索引表与散列表。\n
+ * 命中时段描述表直接使用映射，不再读取与解码段表，打开符号表时不再扫描与转换；\n
+ * 无需转换的内容（本机字节序的符号表、字符串表等）与源文件相同，不复制，仍取自源文件。
+ */
+#define NK_ELF_CACHE_MAGIC      (0x43454b4e) ///< "NKEC"
+#define NK_ELF_CACHE_VERSION    (2)
+
+/// 参与散列的文件头长度，覆盖 32/64 位 ELF 头。
+#define NK_ELF_CACHE_HASHED     (64)
+
+typedef struct NK_ElfCacheHeader {
+
+    NK_UInt32 Magic;
+
+    NK_UInt32 Version;
+
+    /// 段描述项长度，结构变化时缓存失效
+    NK_UInt32 Entsize;
+
+    /// 文件类别，ELFCLASS32 或 ELFCLASS64
+    NK_Byte Class;
+
+    /// 文件字节序与本机不同
+    NK_Byte Swap;
+
+    /// 段表通过校验，见 @ref NK_PrivatedParser::Valid
+    NK_Byte Valid;
+
+    NK_Byte Reserved;
+
+    /// 源文件标识
+    NK_FileStat Stat;
+
+    /// 源文件头部散列
+    NK_UInt64 Hash;
+
+    /// 解码后的 ELF 头
+    NK_ElfHeader Header;
+
+    /// 段描述表偏移
+    NK_UInt64 Sections;
+
+    /// 段名池偏移与长度
+    NK_UInt64 Names;
+
+    NK_UInt64 NamesSize;
+
+    /// 已转换的区间数与区间表偏移
+    NK_UInt64 Count;
+
+    NK_UInt64 Entries;
+
+} NK_ElfCacheHeader;
+
+/**
+ * 已转换为本机字节序的区间，命中时挂到 @ref NK_PrivatedParser::Native。
+ */
+typedef struct NK_ElfCacheEntry {
+
+    /// 区间在源文件中的偏移
+    NK_UInt64 Offset;
+
+    /// 区间长度
+    NK_UInt64 Size;
+
+    /// 区间数据在缓存文件中的偏移
+    NK_UInt64 Data;
+
+} NK_ElfCacheEntry;
+
+/**
+ * 段校验结果，见 @ref Elf_validate()、@ref Elf_open_symtab()。
+ */
+/// 段内容完整落在源内，NOBITS 段视为满足
+#define NK_ELF_CHECK_RANGE      (1 << 0)
+/// 符号表项长度与类别一致、长度为项长度整数倍，链接的字符串表与扩展段索引表完整
+#define NK_ELF_CHECK_SYMTAB     (1 << 1)
+/// 字符串表以 '\0' 结尾，符号名偏移均落在其中，需要时扩展段索引表存在；\n
+/// 只记录在解析缓存的段描述中，命中时打开符号表不再扫描，见 @ref NK_ElfSymtab::Checked
+#define NK_ELF_CHECK_SYMBOLS    (1 << 2)
+
+/**
+ * 打开的符号表，由 @ref Elf_open_symtab() 构建并挂在段描述上，各符号表方法共用。
+ */
+typedef struct NK_ElfSymtab {
+
+    const NK_ElfSection *Section;
+
+    /// 本机字节序的符号表项
+    const NK_Void *Sym;
+
+    /// 符号数
+    NK_Size64 Cnt;
+
+    /// 关联的符号字符串表
+    const NK_Char *Strtab;
+
+    NK_Size64 StrSize;
+
+    /// 扩展段索引表，没有时为 NK_Nil
+    const NK_UInt32 *Xindex;
+
+    NK_Size64 Xcnt;
+
+    /// 已通过校验，循环内无需逐项检查
+    NK_Boolean Checked;
+
+} NK_ElfSymtab;
+
+/**
+ * 符号名索引的槽，Index 为 符号索引 + 1，0 表示空槽；Tag 为符号名散列的高 32 位，\n
+ * 探测时先比较 Tag，不同则无需访问符号表。
+ */
+typedef struct NK_ElfSlot {
+
+    NK_UInt32 Index;
+
+    NK_UInt32 Tag;
+
+} NK_ElfSlot;
+
+/**
+ * 为没有散列表的符号表构建的符号名索引，开放定址，线性探测，见 @ref Elf_build_index()。
+ */
+typedef struct NK_ElfIndex {
+
+    /// 被索引的符号表
+    const NK_ElfSymtab *Symtab;
+
+    NK_ElfSlot *Slots;
+
+    /// 槽数 - 1
+    NK_UInt64 Mask;
+
+} NK_ElfIndex;
+
+/**
+ * 按名查找符号使用的散列表类型。
+ */
+typedef enum NK_ElfLookupKind {
+
+    /// 没有可用的散列表
+    NK_ELF_LOOKUP_NONE = 0,
+
+    /// SHT_GNU_HASH（DT_GNU_HASH）
+    NK_ELF_LOOKUP_GNU,
+
+    /// SHT_HASH（DT_HASH）
+    NK_ELF_LOOKUP_SYSV,
+
+    /// 文件没有散列表时为动态符号表构建的索引
+    NK_ELF_LOOKUP_INDEX,
+
+} NK_ElfLookupKind;
+
+/**
+ * 按名查找符号使用的散列表，首次查找时选定并构建，见 @ref Elf_build_lookup()。
+ */
+typedef struct NK_ElfLookup {
+
+    NK_ElfLookupKind Kind;
+
+    /// 被散列表索引的符号表
+    const NK_ElfSymtab *Symtab;
+
+    /// 桶数；GNU 散列表另有首个被散列的符号索引、布隆过滤器字数与第二个散列的移位
+    NK_UInt32 Nbuckets;
+
+    NK_UInt32 Symoffset;
+
+    NK_UInt32 BloomSize;
+
+    NK_UInt32 BloomShift;
+
+    /// 布隆过滤器，字长与类别的地址长度相同
+    const NK_Void *Bloom;
+
+    const NK_UInt32 *Buckets;
+
+    /// 散列链，GNU 散列表第 i 项对应符号 Symoffset + i，SysV 散列表第 i 项对应符号 i
+    const NK_UInt32 *Chain;
+
+    NK_UInt32 ChainCnt;
+
+    /// 构建的索引
+    NK_ElfIndex Index;
+
+} NK_ElfLookup;
+
+/**
+ * 地址索引项，按起始地址升序排列。
+ */
+typedef struct NK_ElfExtent {
+
+    NK_UInt64 Addr;
+
+    /// 覆盖范围的结束地址（不含）
+    NK_UInt64 End;
+
+    /// 符号索引
+    NK_UInt32 Index;
+
+    /// 同一地址上的优先级，见 @ref Elf_extent_rank()
+    NK_UInt32 Rank;
+
+    /// 覆盖本项起始地址的前一个索引项的下标 + 1，没有时为 0，见 @ref Elf_enclosing()
+    NK_UInt32 Outer;
+
+} NK_ElfExtent;
+
+/**
+ * 按地址查找符号的索引，见 @ref Elf_build_addresses()。
+ */
+typedef struct NK_ElfAddresses {
+
+    /// 被索引的符号表，没有可索引的符号表时为 NK_Nil
+    const NK_ElfSymtab *Symtab;
+
+    /// 被索引的符号表的段索引
+    NK_Int Table;
+
+    /// 按地址排序的索引项
+    NK_ElfExtent *Extents;
+
+    NK_UInt64 Cnt;
+
+    /// Eytzinger 布局的起始地址，下标从 1 开始，按缓存行对齐
+    NK_UInt64 *Keys;
+
+    /// Keys 中各位置对应的 Extents 下标
+    NK_UInt32 *Ranks;
+
+} NK_ElfAddresses;
+
+/**
+ * 结构体的字段布局，跨字节序转换时使用，见 @ref NK_SwapArray()。
+ */
+typedef struct NK_ElfLayout {
+
+    /// 依次各字段的长度
+    const NK_Byte *Fields;
+
+    /// 字段数
+    NK_Int Count;
+
+} NK_ElfLayout;
+
+struct NK_PrivatedParser;
+
+/**
+ * ELF 类别（32/64 位）的解码实现，由 parser_class.h 为每个类别生成一份。\n
+ * 解析时按 e_ident[EI_CLASS] 选定一次，之后各方法直接调用对应类别的实现，\n
+ * 内层循环按该类别的结构布局访问字段，不再逐字段判断类别。
+ */
+typedef struct NK_ElfClass {
+
+    /// ELFCLASS32 或 ELFCLASS64
+    NK_Byte Class;
+
+    /// ELF 头、段表项、程序头表项、符号表项长度
+    NK_Size Ehsize;
+
+    NK_Size Shentsize;
+
+    NK_Size Phentsize;
+
+    NK_Size Symentsize;
+
+    /// 地址长度
+    NK_Size Addrsize;
+
+    /// ELF 头、段表项、程序头表项、符号表项的字段布局
+    NK_ElfLayout EhdrLayout;
+
+    NK_ElfLayout ShdrLayout;
+
+    NK_ElfLayout PhdrLayout;
+
+    NK_ElfLayout SymLayout;
+
+    /// 地址长度的字，如 GNU 散列表的布隆过滤器
+    NK_ElfLayout AddrLayout;
+
+    /// 解码 ELF 头
+    NK_Void (*ehdr)(const NK_Void *Raw, NK_ElfHeader *Header);
+
+    /// 解码段表中第 Index 项
+    NK_Void (*shdr)(const NK_Void *Table, NK_Size64 Index, NK_ElfShdr *Shdr);
+
+    /// 解码程序头表中第 Index 项
+    NK_Void (*phdr)(const NK_Void *Table, NK_Size64 Index, NK_ElfPhdr *Phdr);
+
+    /// 扫描符号表，返回最大的符号名偏移，@ref Xneeded 返回是否有段索引为 SHN_XINDEX 的符号
+    NK_UInt64 (*scan)(const NK_Void *Sym, NK_Size64 Cnt, NK_Boolean *Xneeded);
+
+    /// 解码符号表中第 @ref Index 个符号
+    NK_Void (*symbol)(const NK_ElfSymtab *Symtab, NK_Size64 Index, NK_ElfSymbol *Symbol);
+
+    /// GNU 散列表的布隆过滤器检查，返回 NK_False 时符号一定不存在
+    NK_Boolean (*bloom)(const NK_ElfLookup *Lookup, NK_UInt32 Hash);
+
+} NK_ElfClass;
+
 /**
  * Parser 模块私有句柄，句柄访问模块内部的私有成员。\n
  * 内存在 Parser 模块创建时统一分配。\n
@@ -38,44 +558,2751 @@
  *             | NK_Parser
  *
  */
-typedef struct NK_PrivatedParser {
+typedef struct NK_PrivatedParser {
+
+    /// elf 源路径
+    NK_Char Path[256];
+
+    /// 解析选项
+    NK_UInt32 Flags;
+
+    /// elf 源类型
+    NK_ElfSource Source;
+
+    /// elf 源，整体映射或加载时有效
+    NK_PVoid Src;
+
+    /// elf 源长度
+    NK_Size64 Size;
+
+    /// 延迟加载时的文件描述符
+    NK_Int Fd;
+
+    /// 延迟加载或流式读取时已读取的区间
+    NK_ElfRegion *Regions;
+
+    /// 调用者内存的所有权已转移，销毁时释放
+    NK_Boolean Owned;
+
+    /// 命中的解析缓存文件映射
+    NK_PVoid Cache;
+
+    /// 解析缓存文件映射长度
+    NK_Size64 CacheSize;
+
+    /// 访问统计
+    NK_ParseStats Stats;
+
+    /// 文件类别的解码实现，解析成功后有效
+    const NK_ElfClass *Class;
+
+    /// 文件字节序与本机不同
+    NK_Boolean Swap;
+
+    /// 跨字节序时已转换为本机字节序的段表与符号表
+    NK_ElfRegion *Native;
+
+    /// 段描述表，共 Header.Shnum 项，命中解析缓存时指向缓存文件映射
+    NK_ElfSection *Sections;
+
+    /// 段名所在的字符串：段表字符串表，或解析缓存中的段名池
+    const NK_Char *Shstrtab;
+
+    /// 已打开的符号表，按段索引，共 Header.Shnum 项，见 @ref Elf_open_symtab()
+    NK_ElfSymtab **Symtabs;
+
+    /// 段表通过校验：所有段在源内，符号表与其字符串表、扩展段索引表的关系有效
+    NK_Boolean Valid;
+
+    /// 段名散列索引，开放定址，槽内为 段索引 + 1，0 表示空槽
+    NK_UInt32 *Names;
+
+    /// 段名散列索引槽数 - 1
+    NK_UInt64 NamesMask;
+
+    /// 按名查找动态符号的散列表
+    NK_ElfLookup *Lookup;
+
+    /// .symtab 的符号名索引，动态符号中查不到时才构建
+    NK_ElfIndex *Statics;
+
+    /// 按地址查找符号的索引，第一次按地址查找时构建
+    NK_ElfAddresses *Addresses;
+
+    /// 解码后的 ELF 头
+    NK_ElfHeader Header;
+
+    /// 段描述表、段名索引与符号表的构建锁
+    pthread_mutex_t Lock;
+
+    /// Regions、Native 的插入锁
+    pthread_mutex_t RegionLock;
+
+} NK_PrivatedParser;
+
+/**
+ * 通过模块公有句柄获取私有句柄。
+ */
+static inline NK_PrivatedParser *
+PRIVATED(NK_Parser *Public) {
+
+    /// 偏移到私有句柄。
+    return (NK_PrivatedParser *)Public - 1;
+}
+
+/**
+ * 定义私有句柄。
+ */
+#define DECLARE_PRIVATED() NK_PrivatedParser *Privated = PRIVATED(Public)
+
+/**
+ * 并发模型：解析完成后，同一句柄的各方法可被多个线程同时调用。\n
+ * 解析后才构建的状态（区间、段描述表、段名索引、符号表）只增不删，\n
+ * 构建完成后以 release 语义发布，读取方以 acquire 语义读取，已构建时无需加锁；\n
+ * 未构建时在锁内二次检查后构建，每项只构建一次。
+ */
+#define NK_ELF_LOAD(__ptr)          __atomic_load_n(&(__ptr), __ATOMIC_ACQUIRE)
+#define NK_ELF_PUBLISH(__ptr, __v)  __atomic_store_n(&(__ptr), (__v), __ATOMIC_RELEASE)
+
+/**
+ * 分配一段区间。
+ */
+static NK_ElfRegion *
+Elf_new_region(NK_Size64 Offset, NK_Size64 Size) {
+
+    NK_ElfRegion *Region = NK_Nil;
+
+    /// 区间需能放入本进程地址空间。
+    NK_EXPECT_RETURN_VAL(Size <= (NK_Size64)(size_t)-1 - sizeof(NK_ElfRegion), NK_Nil);
+
+    Region = malloc(sizeof(NK_ElfRegion) + (size_t)Size);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Region, NK_Nil);
+
+    Region->Next = NK_Nil;
+    Region->Offset = Offset;
+    Region->Size = Size;
+    Region->Data = (NK_PByte)(Region + 1);
+
+    return Region;
+}
+
+/**
+ * 在区间链表 @ref Head 中查找包含 [@ref Offset, @ref Offset + @ref Size) 的区间，\n
+ * 返回区间内对应的地址，没有时返回 NK_Nil。
+ */
+static NK_PByte
+Elf_find_region(NK_ElfRegion *Head, NK_Size64 Offset, NK_Size64 Size) {
+
+    NK_ElfRegion *Region = NK_Nil;
+
+    for (Region = Head; NK_Nil != Region; Region = Region->Next) {
+        if (Offset >= Region->Offset && Offset + Size <= Region->Offset + Region->Size) {
+            return Region->Data + (Offset - Region->Offset);
+        }
+    }
+
+    return NK_Nil;
+}
+
+/**
+ * 获取 elf 源中 [@ref Offset, @ref Offset + @ref Size) 区间的数据。\n
+ * 整体映射或加载的源直接返回源内地址，\n
+ * 延迟加载的源优先复用已读取的区间，否则从文件 pread 该区间。\n
+ * 越界或读取失败返回 NK_Nil。
+ */
+static NK_PVoid
+Elf_fetch(NK_PrivatedParser *Privated, NK_Size64 Offset, NK_Size64 Size) {
+
+    NK_ElfRegion *Region = NK_Nil;
+    NK_PByte Data = NK_Nil;
+
+    /// 区间检查。
+    NK_EXPECT_RETURN_VAL(Offset <= Privated->Size && Size <= Privated->Size - Offset, NK_Nil);
+
+    if (NK_ELF_SRC_MAP == Privated->Source || NK_ELF_SRC_HEAP == Privated->Source
+        || NK_ELF_SRC_MEMORY == Privated->Source) {
+        NK_EXPECT_RETURN_VAL(NK_Nil != Privated->Src, NK_Nil);
+        return (NK_PByte)Privated->Src + Offset;
+    }
+
+    /// 复用已读取的区间。
+    Data = Elf_find_region(NK_ELF_LOAD(Privated->Regions), Offset, Size);
+    if (NK_Nil != Data) {
+        return Data;
+    }
+
+    /// 流式读取的源只保留解析时选中的区间。
+    NK_EXPECT_RETURN_VAL(NK_ELF_SRC_LAZY == Privated->Source, NK_Nil);
+
+    /// 在锁外读取，不阻塞其他线程的读取。
+    Region = Elf_new_region(Offset, Size);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Region, NK_Nil);
+
+    if ((NK_SSize64)Size != NK_ReadFileAt(Privated->Fd, Offset, Region->Data, Size)) {
+        free(Region);
+        return NK_Nil;
+    }
+
+    /// 其他线程可能已读入同一区间，插入前再查一次。
+    pthread_mutex_lock(&Privated->RegionLock);
+    Region->Next = Privated->Regions;
+    Data = Elf_find_region(Region->Next, Offset, Size);
+    if (NK_Nil == Data) {
+        Data = Region->Data;
+        NK_ELF_PUBLISH(Privated->Regions, Region);
+        Region = NK_Nil;
+    }
+    pthread_mutex_unlock(&Privated->RegionLock);
+
+    free(Region);
+
+    return Data;
+}
+
+/**
+ * 释放区间链表。
+ */
+static NK_Void
+Elf_drop_regions(NK_ElfRegion **Regions) {
+
+    while (NK_Nil != Regions[0]) {
+        NK_ElfRegion *Next = Regions[0]->Next;
+        free(Regions[0]);
+        Regions[0] = Next;
+    }
+}
+
+/**
+ * 按输出方法的访问模式发出提示：\n
+ * 映射的源使用 madvise，延迟加载的源对文件使用 posix_fadvise，其余源无需提示。
+ */
+static NK_Void
+Elf_advise(NK_PrivatedParser *Privated, NK_Size64 Offset, NK_Size64 Size, NK_Int Advice) {
+
+    if (0 == Size) {
+        return;
+    }
+
+    if (NK_ELF_SRC_MAP == Privated->Source) {
+        NK_AdviseBuffer(Privated->Src, Offset, Size, Advice);
+        __atomic_fetch_add(&Privated->Stats.Advices, 1, __ATOMIC_RELAXED);
+    } else if (NK_ELF_SRC_LAZY == Privated->Source && Privated->Fd >= 0) {
+        NK_AdviseFile(Privated->Fd, Offset, Size, Advice);
+        __atomic_fetch_add(&Privated->Stats.Advices, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * 累计输出方法执行期间的缺页次数，@ref Major、@ref Minor 为开始时的快照。
+ */
+static NK_Void
+Elf_account(NK_PrivatedParser *Privated, NK_UInt64 Major, NK_UInt64 Minor) {
+
+    NK_UInt64 MajorNow = Major;
+    NK_UInt64 MinorNow = Minor;
+
+    NK_GetFaults(&MajorNow, &MinorNow);
+    __atomic_fetch_add(&Privated->Stats.MajorFaults, MajorNow - Major, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&Privated->Stats.MinorFaults, MinorNow - Minor, __ATOMIC_RELAXED);
+}
+
+/**
+ * 段类型名。
+ */
+static const NK_Char *
+Elf_section_type(NK_UInt32 Type) {
+
+    switch (Type)
+    {
+    case SHT_NULL:          return "NULL";
+    case SHT_PROGBITS:      return "PROGBITS";
+    case SHT_SYMTAB:        return "SYMTAB";
+    case SHT_STRTAB:        return "STRTAB";
+    case SHT_RELA:          return "RELA";
+    case SHT_HASH:          return "HASH";
+    case SHT_DYNAMIC:       return "DYNAMIC";
+    case SHT_NOTE:          return "NOTE";
+    case SHT_NOBITS:        return "NOBITS";
+    case SHT_REL:           return "REL";
+    case SHT_SHLIB:         return "SHLIB";
+    case SHT_DYNSYM:        return "DYNSYM";
+    case SHT_INIT_ARRAY:    return "INIT_ARRAY";
+    case SHT_FINI_ARRAY:    return "FINI_ARRAY";
+    case SHT_PREINIT_ARRAY: return "PREINIT_ARRAY";
+    case SHT_GROUP:         return "GROUP";
+    case SHT_SYMTAB_SHNDX:  return "SYMTAB_SHNDX";
+    default:                return "";
+    }
+}
+
+/**
+ * 段标志，@ref Flags 至少容纳 16 字节。
+ */
+static NK_Void
+Elf_section_flags(NK_UInt64 Value, NK_Char *Flags) {
+
+    Flags[0] = '\0';
+    if (Value & SHF_WRITE)              strcat(Flags, "W");
+    if (Value & SHF_ALLOC)              strcat(Flags, "A");
+    if (Value & SHF_EXECINSTR)          strcat(Flags, "X");
+    if (Value & SHF_MERGE)              strcat(Flags, "M");
+    if (Value & SHF_STRINGS)            strcat(Flags, "S");
+    if (Value & SHF_INFO_LINK)          strcat(Flags, "I");
+    if (Value & SHF_LINK_ORDER)         strcat(Flags, "L");
+    if (Value & SHF_OS_NONCONFORMING)   strcat(Flags, "O");
+    if (Value & SHF_GROUP)              strcat(Flags, "G");
+    if (Value & SHF_TLS)                strcat(Flags, "T");
+    if (Value & SHF_COMPRESSED)         strcat(Flags, "C");
+}
+
+/**
+ * 符号类型、绑定与可见性名，两种类别的编码相同。
+ */
+static const NK_Char *
+Elf_symbol_type(NK_Byte Type) {
+
+    switch (Type)
+    {
+    case STT_NOTYPE:    return "NOTYPE";
+    case STT_OBJECT:    return "OBJECT";
+    case STT_FUNC:      return "FUNC";
+    case STT_SECTION:   return "SECTION";
+    case STT_FILE:      return "FILE";
+    case STT_COMMON:    return "COMMON";
+    case STT_TLS:       return "TLS";
+    default:            return "";
+    }
+}
+
+static const NK_Char *
+Elf_symbol_bind(NK_Byte Bind) {
+
+    switch (Bind)
+    {
+    case STB_LOCAL:     return "LOCAL";
+    case STB_GLOBAL:    return "GLOBAL";
+    case STB_WEAK:      return "WEAK";
+    default:            return "";
+    }
+}
+
+static const NK_Char *
+Elf_symbol_vis(NK_Byte Vis) {
+
+    switch (Vis)
+    {
+    case STV_DEFAULT:   return "DEFAULT";
+    case STV_INTERNAL:  return "INTERNAL";
+    case STV_HIDDEN:    return "HIDDEN";
+    case STV_PROTECTED: return "PROTECTED";
+    default:            return "";
+    }
+}
+
+/**
+ * 程序段类型名。
+ */
+static const NK_Char *
+Elf_segment_type(NK_UInt32 Type) {
+
+    switch (Type)
+    {
+    case PT_NULL:           return "NULL";
+    case PT_LOAD:           return "LOAD";
+    case PT_DYNAMIC:        return "DYNAMIC";
+    case PT_INTERP:         return "INTERP";
+    case PT_NOTE:           return "NOTE";
+    case PT_SHLIB:          return "SHLIB";
+    case PT_PHDR:           return "PHDR";
+    case PT_TLS:            return "TLS";
+    case PT_GNU_EH_FRAME:   return "GNU_EH_FRAME";
+    case PT_GNU_STACK:      return "GNU_STACK";
+    case PT_GNU_RELRO:      return "GNU_RELRO";
+    case PT_GNU_PROPERTY:   return "GNU_PROPERTY";
+    default:                return "";
+    }
+}
+
+/**
+ * 程序段标志，@ref Flags 至少容纳 4 字节。
+ */
+static NK_Void
+Elf_segment_flags(NK_UInt32 Value, NK_Char *Flags) {
+
+    Flags[0] = (Value & PF_R) ? 'R' : ' ';
+    Flags[1] = (Value & PF_W) ? 'W' : ' ';
+    Flags[2] = (Value & PF_X) ? 'E' : ' ';
+    Flags[3] = '\0';
+}
+
+/**
+ * 输出一个符号。
+ */
+static NK_Void
+Elf_print_symbol(const NK_ElfSymbol *Symbol) {
+
+    TRACE("  [%4llu] %08llx %-8llu %-8s %-8s %-9s %4u %s\n", (unsigned long long)Symbol->Index
+        , (unsigned long long)Symbol->Value, (unsigned long long)Symbol->Size
+        , Elf_symbol_type(Symbol->Type), Elf_symbol_bind(Symbol->Bind)
+        , Elf_symbol_vis(Symbol->Visibility), Symbol->Shndx, Symbol->Name);
+}
+
+/**
+ * 段表长度。
+ */
+static inline NK_Size64
+Elf_shdr_size(NK_PrivatedParser *Privated) {
+
+    return (NK_Size64)Privated->Header.Shnum * Privated->Class->Shentsize;
+}
+
+/**
+ * 在已转换的区间链表 @ref Head 中查找与 [@ref Offset, @ref Offset + @ref Size) 完全相同的区间。
+ */
+static NK_PByte
+Elf_find_native(NK_ElfRegion *Head, NK_Size64 Offset, NK_Size64 Size) {
+
+    NK_ElfRegion *Region = NK_Nil;
+
+    for (Region = Head; NK_Nil != Region; Region = Region->Next) {
+        if (Offset == Region->Offset && Size == Region->Size) {
+            return Region->Data;
+        }
+    }
+
+    return NK_Nil;
+}
+
+/**
+ * 获取 [@ref Offset, @ref Offset + @ref Size) 区间内按 @ref Layout 排列的结构体数组。\n
+ * 文件字节序与本机相同时直接返回源数据，\n
+ * 否则首次访问时整体转换为本机字节序并缓存，输出方法的循环对两种情况完全相同。
+ */
+static NK_PVoid
+Elf_native(NK_PrivatedParser *Privated, NK_Size64 Offset, NK_Size64 Size, NK_Size Entsize, const NK_ElfLayout *Layout) {
+
+    NK_ElfRegion *Region = NK_Nil;
+    NK_PByte Data = NK_Nil;
+    NK_PByte Raw = NK_Nil;
+
+    if (!Privated->Swap) {
+        return Elf_fetch(Privated, Offset, Size);
+    }
+
+    /// 已转换的区间（含解析缓存中的）无需再读取原始数据。
+    Data = Elf_find_native(NK_ELF_LOAD(Privated->Native), Offset, Size);
+    if (NK_Nil != Data) {
+        return Data;
+    }
+
+    Raw = Elf_fetch(Privated, Offset, Size);
+    if (NK_Nil == Raw) {
+        return NK_Nil;
+    }
+
+    /// 转换在锁内进行，同一区间只转换一次。
+    pthread_mutex_lock(&Privated->RegionLock);
+
+    Data = Elf_find_native(Privated->Native, Offset, Size);
+    if (NK_Nil == Data) {
+
+        Region = Elf_new_region(Offset, Size);
+        if (NK_Nil != Region) {
+
+            /// 整体转换一次，不足一项的尾部原样保留。
+            NK_SwapArray(Region->Data, Raw, Size / Entsize, Layout->Fields, Layout->Count);
+            memcpy(Region->Data + Size / Entsize * Entsize, Raw + Size / Entsize * Entsize, (size_t)(Size % Entsize));
+
+            Region->Next = Privated->Native;
+            NK_ELF_PUBLISH(Privated->Native, Region);
+            Data = Region->Data;
+        }
+    }
+
+    pthread_mutex_unlock(&Privated->RegionLock);
+
+    return Data;
+}
+
+/**
+ * 获取本机字节序的段表，失败返回 NK_Nil。
+ */
+static NK_PVoid
+Elf_shdr_table(NK_PrivatedParser *Privated) {
+
+    return Elf_native(Privated, Privated->Header.Shoff, Elf_shdr_size(Privated)
+        , Privated->Class->Shentsize, &Privated->Class->ShdrLayout);
+}
+
+/**
+ * 校验段表，结果记在各段的 Checks 上，全部通过返回 NK_True。\n
+ * 只检查段表本身，不读取段内容；符号表内容在首次打开时扫描一次，见 @ref Elf_open_symtab()。\n
+ * 流式读取的源未保留的段无法访问，不检查其范围。
+ */
+static NK_Boolean
+Elf_validate(NK_PrivatedParser *Privated, NK_ElfSection *Sections) {
+
+    const NK_ElfHeader *Header = &Privated->Header;
+    NK_Size Symentsize = Privated->Class->Symentsize;
+    NK_Boolean Valid = NK_True;
+    NK_UInt32 i;
+
+    for (i = 0; i < Header->Shnum; i++) {
+
+        NK_ElfSection *Section = &Sections[i];
+
+        if (SHT_NOBITS == Section->Type
+            || (Section->Offset <= Privated->Size && Section->Size <= Privated->Size - Section->Offset)) {
+            Section->Checks |= NK_ELF_CHECK_RANGE;
+        } else if (NK_ELF_SRC_STREAM != Privated->Source) {
+            Valid = NK_False;
+        }
+    }
+
+    for (i = 0; i < Header->Shnum; i++) {
+
+        NK_ElfSection *Section = &Sections[i];
+
+        if (SHT_SYMTAB != Section->Type && SHT_DYNSYM != Section->Type) {
+            continue;
+        }
+
+        if (!(Section->Checks & NK_ELF_CHECK_RANGE) || SHT_NOBITS == Section->Type
+            || Symentsize != Section->Entsize || 0 != Section->Size % Symentsize
+            || Section->Link >= Header->Shnum || SHT_STRTAB != Sections[Section->Link].Type
+            || !(Sections[Section->Link].Checks & NK_ELF_CHECK_RANGE)) {
+            Valid = NK_False;
+            continue;
+        }
+
+        if (0 != Section->Xindex && (!(Sections[Section->Xindex].Checks & NK_ELF_CHECK_RANGE)
+            || Sections[Section->Xindex].Size / sizeof(NK_UInt32) < Section->Size / Symentsize)) {
+            Valid = NK_False;
+            continue;
+        }
+
+        Section->Checks |= NK_ELF_CHECK_SYMTAB;
+    }
+
+    return Valid;
+}
+
+/**
+ * 由段表构建段描述表，之后各方法直接复用。\n
+ * 段名在构建时校验，须以 '\0' 结尾且完整落在段表字符串表内，否则视为空名。\n
+ * 段表不可读时返回 NK_Nil。
+ */
+static NK_ElfSection *
+Elf_build_sections(NK_PrivatedParser *Privated) {
+
+    const NK_ElfHeader *Header = &Privated->Header;
+    NK_ElfSection *Sections = NK_Nil;
+    NK_PVoid Table = NK_Nil;
+    const NK_Char *Shstrtab = NK_Nil;
+    NK_UInt64 ShstrSize = 0;
+    NK_ElfShdr Shdr;
+    NK_UInt32 i;
+
+    /// 段表与段名只在此读取一次，提前读入。
+    Elf_advise(Privated, Header->Shoff, Elf_shdr_size(Privated), NK_ADVICE_WILLNEED);
+    Table = Elf_shdr_table(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Table, NK_Nil);
+
+    /// 没有段表字符串表时段名均为空。
+    if (Header->Shstrndx < Header->Shnum) {
+        Privated->Class->shdr(Table, Header->Shstrndx, &Shdr);
+        if (SHT_NOBITS != Shdr.Type) {
+            Elf_advise(Privated, Shdr.Offset, Shdr.Size, NK_ADVICE_WILLNEED);
+            Shstrtab = Elf_fetch(Privated, Shdr.Offset, Shdr.Size);
+            NK_EXPECT_RETURN_VAL(NK_Nil != Shstrtab, NK_Nil);
+            ShstrSize = Shdr.Size;
+        }
+    }
+
+    /// 多分配一项，没有段时也得到有效的表。
+    Sections = calloc((NK_Size)Header->Shnum + 1, sizeof(NK_ElfSection));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Sections, NK_Nil);
+    Privated->Symtabs = calloc((NK_Size)Header->Shnum + 1, sizeof(NK_ElfSymtab *));
+    if (NK_Nil == Privated->Symtabs) {
+        free(Sections);
+        return NK_Nil;
+    }
+
+    for (i = 0; i < Header->Shnum; i++) {
+
+        NK_ElfSection *Section = &Sections[i];
+
+        Privated->Class->shdr(Table, i, &Shdr);
+
+        if (Shdr.Name < ShstrSize) {
+            NK_Size Len = strnlen(Shstrtab + Shdr.Name, (size_t)(ShstrSize - Shdr.Name));
+            if (Len < ShstrSize - Shdr.Name) {
+                Section->Name = Shdr.Name;
+                Section->NameLen = Len;
+            }
+        }
+
+        Section->Type = Shdr.Type;
+        Section->Flags = Shdr.Flags;
+        Section->Addr = Shdr.Addr;
+        Section->Offset = Shdr.Offset;
+        Section->Size = Shdr.Size;
+        Section->Link = Shdr.Link;
+        Section->Info = Shdr.Info;
+        Section->Addralign = Shdr.Addralign;
+        Section->Entsize = Shdr.Entsize;
+
+        /// 扩展段索引表挂到其符号表上，同一遍完成。
+        if (SHT_SYMTAB_SHNDX == Shdr.Type && Shdr.Link < Header->Shnum && 0 == Sections[Shdr.Link].Xindex) {
+            Sections[Shdr.Link].Xindex = i;
+        }
+    }
+
+    Privated->Shstrtab = Shstrtab;
+    Privated->Valid = Elf_validate(Privated, Sections);
+    NK_ELF_PUBLISH(Privated->Sections, Sections);
+
+    return Sections;
+}
+
+/**
+ * 获取段描述表，首次调用时在锁内构建，见 @ref Elf_build_sections()。
+ */
+static NK_ElfSection *
+Elf_sections(NK_PrivatedParser *Privated) {
+
+    NK_ElfSection *Sections = NK_ELF_LOAD(Privated->Sections);
+
+    if (NK_Nil != Sections) {
+        return Sections;
+    }
+
+    pthread_mutex_lock(&Privated->Lock);
+    Sections = Privated->Sections;
+    if (NK_Nil == Sections) {
+        Sections = Elf_build_sections(Privated);
+    }
+    pthread_mutex_unlock(&Privated->Lock);
+
+    return Sections;
+}
+
+/**
+ * 段名，无效时为空串。
+ */
+static inline const NK_Char *
+Elf_section_name(const NK_PrivatedParser *Privated, const NK_ElfSection *Section) {
+
+    return Section->NameLen > 0 ? Privated->Shstrtab + Section->Name : "";
+}
+
+/**
+ * 构建段名散列索引，槽数取不小于段数两倍的 2 的幂，线性探测。\n
+ * 段按索引顺序插入，同名的段在探测序列中索引小的在前。
+ */
+static NK_Int
+Elf_index_names(NK_PrivatedParser *Privated, NK_ElfSection *Sections) {
+
+    NK_UInt64 Slots = 16;
+    NK_UInt32 *Names = NK_Nil;
+    NK_UInt32 i;
+
+    while (Slots < (NK_UInt64)Privated->Header.Shnum * 2)
+        Slots <<= 1;
+
+    Names = calloc((size_t)Slots, sizeof(NK_UInt32));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Names, -1);
+
+    for (i = 0; i < Privated->Header.Shnum; i++) {
+
+        NK_UInt64 Slot = NK_Hash64((NK_PVoid)Elf_section_name(Privated, &Sections[i]), Sections[i].NameLen) & (Slots - 1);
+
+        while (0 != Names[Slot])
+            Slot = (Slot + 1) & (Slots - 1);
+
+        Names[Slot] = i + 1;
+    }
+
+    Privated->NamesMask = Slots - 1;
+    NK_ELF_PUBLISH(Privated->Names, Names);
+
+    return 0;
+}
+
+/**
+ * 按段名查找段索引，不存在返回 -1。
+ */
+static NK_Int
+Elf_lookup_section(NK_PrivatedParser *Privated, const NK_Char *Name) {
+
+    NK_ElfSection *Sections = NK_Nil;
+    NK_UInt32 *Names = NK_Nil;
+    NK_Size Len = strlen(Name);
+    NK_UInt64 Slot = 0;
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Sections, -1);
+
+    Names = NK_ELF_LOAD(Privated->Names);
+    if (NK_Nil == Names) {
+        pthread_mutex_lock(&Privated->Lock);
+        if (NK_Nil == Privated->Names) {
+            Elf_index_names(Privated, Sections);
+        }
+        Names = Privated->Names;
+        pthread_mutex_unlock(&Privated->Lock);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Names, -1);
+    }
+
+    Slot = NK_Hash64((NK_PVoid)Name, Len) & Privated->NamesMask;
+
+    for (; 0 != Names[Slot]; Slot = (Slot + 1) & Privated->NamesMask) {
+
+        const NK_ElfSection *Section = &Sections[Names[Slot] - 1];
+
+        if (Len == Section->NameLen && 0 == memcmp(Elf_section_name(Privated, Section), Name, Len)) {
+            return (NK_Int)(Names[Slot] - 1);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * 按类别展开类型、宏与函数名，供 parser_class.h 使用，\n
+ * 如 ELF_CLASS 为 64 时 ElfW(Shdr) 为 Elf64_Shdr，ELFW(ST_TYPE) 为 ELF64_ST_TYPE，ElfN(Elf_section) 为 Elf_section64。
+ */
+#define NK_ELF_CAT(__a, __b)    __a##__b
+#define NK_ELF_PASTE(__a, __b)  NK_ELF_CAT(__a, __b)
+
+#define ElfW(__type)    NK_ELF_PASTE(NK_ELF_PASTE(Elf, ELF_CLASS), _##__type)
+#define ELFW(__macro)   NK_ELF_PASTE(NK_ELF_PASTE(ELF, ELF_CLASS), _##__macro)
+#define ElfN(__name)    NK_ELF_PASTE(__name, ELF_CLASS)
+
+#define ELF_CLASS 32
+#include <parser_class.h>
+#undef ELF_CLASS
+
+#define ELF_CLASS 64
+#include <parser_class.h>
+#undef ELF_CLASS
+
+/**
+ * ELF 头最大长度，延迟加载时首次读取按此长度，两种类别的 ELF 头一次即可读到。
+ */
+#define NK_ELF_EHDR_MAX (sizeof(Elf64_Ehdr))
+
+/**
+ * 扩展段索引表的布局，每项为一个 Elf32_Word。
+ */
+static const NK_Byte Elf_WordFields[] = {sizeof(Elf32_Word)};
+
+static const NK_ElfLayout Elf_WordLayout = {Elf_WordFields, 1};
+
+/**
+ * 构建第 @ref Index 段的符号表：获取本机字节序的符号表项、关联的字符串表与扩展段索引表，\n
+ * 结果挂在段描述上。\n
+ * 构建时扫描一遍符号名偏移，段表与内容均通过校验的符号表，\n
+ * 其后的解码可不做逐项检查，见 @ref NK_ElfSymtab::Checked。
+ */
+static NK_ElfSymtab *
+Elf_build_symtab(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index) {
+
+    NK_ElfSection *Section = &Sections[Index];
+    const NK_ElfClass *Class = Privated->Class;
+    NK_ElfSymtab *Symtab = NK_Nil;
+
+    NK_EXPECT_RETURN_VAL(SHT_SYMTAB == Section->Type || SHT_DYNSYM == Section->Type, NK_Nil);
+    NK_EXPECT_RETURN_VAL(Section->Link < Privated->Header.Shnum, NK_Nil);
+
+    Symtab = calloc(1, sizeof(NK_ElfSymtab));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Symtab, NK_Nil);
+    Symtab->Section = Section;
+
+    /// 获取关联的符号字符串表，按符号名随机访问。
+    const NK_ElfSection *Link = &Sections[Section->Link];
+    Elf_advise(Privated, Link->Offset, Link->Size, NK_ADVICE_RANDOM);
+    Symtab->Strtab = Elf_fetch(Privated, Link->Offset, Link->Size);
+    NK_EXPECT_JUMP(NK_Nil != Symtab->Strtab, _fail_exit);
+    Symtab->StrSize = Link->Size;
+
+    /// 段索引为 SHN_XINDEX 的符号，实际索引在扩展段索引表中。
+    if (0 != Section->Xindex) {
+        const NK_ElfSection *Shndx = &Sections[Section->Xindex];
+        Symtab->Xindex = Elf_native(Privated, Shndx->Offset, Shndx->Size, sizeof(NK_UInt32), &Elf_WordLayout);
+        NK_EXPECT_JUMP(NK_Nil != Symtab->Xindex, _fail_exit);
+        Symtab->Xcnt = Shndx->Size / sizeof(NK_UInt32);
+    }
+
+    /// 符号表顺序访问。
+    Elf_advise(Privated, Section->Offset, Section->Size, NK_ADVICE_SEQUENTIAL);
+    Elf_advise(Privated, Section->Offset, Section->Size, NK_ADVICE_WILLNEED);
+    Symtab->Sym = Elf_native(Privated, Section->Offset, Section->Size, Class->Symentsize, &Class->SymLayout);
+    NK_EXPECT_JUMP(NK_Nil != Symtab->Sym, _fail_exit);
+    Symtab->Cnt = Section->Size / Class->Symentsize;
+
+    /// 扫描内容，确认逐项访问不会越界；解析缓存中的段描述已记录扫描结果。
+    Symtab->Checked = (Section->Checks & NK_ELF_CHECK_SYMBOLS) ? NK_True : NK_False;
+    if (!Symtab->Checked && (Section->Checks & NK_ELF_CHECK_SYMTAB)) {
+
+        NK_Boolean Xneeded = NK_False;
+        NK_UInt64 MaxName = Class->scan(Symtab->Sym, Symtab->Cnt, &Xneeded);
+
+        if (Symtab->StrSize > 0 && '\0' == Symtab->Strtab[Symtab->StrSize - 1]
+            && (0 == Symtab->Cnt || MaxName < Symtab->StrSize)
+            && (!Xneeded || NK_Nil != Symtab->Xindex)) {
+            Symtab->Checked = NK_True;
+        }
+    }
+
+    NK_ELF_PUBLISH(Privated->Symtabs[Index], Symtab);
+
+    return Symtab;
+
+_fail_exit:
+    free(Symtab);
+    return NK_Nil;
+}
+
+/**
+ * 打开第 @ref Index 段的符号表，每个符号表只构建一次，见 @ref Elf_build_symtab()。
+ */
+static const NK_ElfSymtab *
+Elf_open_symtab(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index) {
+
+    NK_ElfSymtab *Symtab = NK_ELF_LOAD(Privated->Symtabs[Index]);
+
+    if (NK_Nil != Symtab) {
+        return Symtab;
+    }
+
+    pthread_mutex_lock(&Privated->Lock);
+    Symtab = Privated->Symtabs[Index];
+    if (NK_Nil == Symtab) {
+        Symtab = Elf_build_symtab(Privated, Sections, Index);
+    }
+    pthread_mutex_unlock(&Privated->Lock);
+
+    return Symtab;
+}
+
+/**
+ * GNU 散列函数（DJB：h * 33 + c），与 DT_GNU_HASH 一致。
+ */
+static NK_UInt32
+Elf_gnu_hash(const NK_Char *Name) {
+
+    NK_UInt32 Hash = 5381;
+    const NK_Byte *c = (const NK_Byte *)Name;
+
+    for (; '\0' != *c; c++)
+        Hash = Hash * 33 + *c;
+
+    return Hash;
+}
+
+/**
+ * SysV 散列函数，与 DT_HASH 一致。
+ */
+static NK_UInt32
+Elf_sysv_hash(const NK_Char *Name) {
+
+    NK_UInt32 Hash = 0;
+    const NK_Byte *c = (const NK_Byte *)Name;
+
+    for (; '\0' != *c; c++) {
+        NK_UInt32 High;
+        Hash = (Hash << 4) + *c;
+        High = Hash & 0xf0000000;
+        if (High)
+            Hash ^= High >> 24;
+        Hash &= ~High;
+    }
+
+    return Hash;
+}
+
+/**
+ * 获取第 @ref Index 段的符号表，调用者已持有 Lock。
+ */
+static const NK_ElfSymtab *
+Elf_locked_symtab(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index) {
+
+    if (NK_Nil != Privated->Symtabs[Index]) {
+        return Privated->Symtabs[Index];
+    }
+
+    return Elf_build_symtab(Privated, Sections, Index);
+}
+
+/**
+ * 由 SHT_GNU_HASH 段（即 DT_GNU_HASH 指向的表）构建查找表：\n
+ * 头部 4 个字（桶数、首个被散列的符号索引、布隆过滤器字数、移位）之后依次为\n
+ * 布隆过滤器、桶与散列链，各部分分别转换为本机字节序。\n
+ * 与 ld.so 一致，布隆过滤器字数须为 2 的幂，移位须小于 32，否则视为损坏。表不完整时返回 -1。
+ */
+static NK_Int
+Elf_load_gnu_hash(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index, NK_ElfLookup *Lookup) {
+
+    const NK_ElfSection *Section = &Sections[Index];
+    const NK_ElfClass *Class = Privated->Class;
+    const NK_UInt32 *Head = NK_Nil;
+    NK_UInt64 Offset = Section->Offset;
+    NK_UInt64 Need = 0;
+
+    NK_EXPECT_RETURN_VAL(Section->Link < Privated->Header.Shnum && SHT_DYNSYM == Sections[Section->Link].Type, -1);
+    NK_EXPECT_RETURN_VAL(Section->Size >= 4 * sizeof(NK_UInt32), -1);
+
+    Head = Elf_native(Privated, Offset, 4 * sizeof(NK_UInt32), sizeof(NK_UInt32), &Elf_WordLayout);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Head, -1);
+
+    Lookup->Nbuckets = Head[0];
+    Lookup->Symoffset = Head[1];
+    Lookup->BloomSize = Head[2];
+    Lookup->BloomShift = Head[3];
+    NK_EXPECT_RETURN_VAL(Lookup->Nbuckets > 0 && Lookup->BloomSize > 0, -1);
+    NK_EXPECT_RETURN_VAL(0 == (Lookup->BloomSize & (Lookup->BloomSize - 1)) && Lookup->BloomShift < 32, -1);
+
+    Need = 4 * sizeof(NK_UInt32) + (NK_UInt64)Lookup->BloomSize * Class->Addrsize + (NK_UInt64)Lookup->Nbuckets * sizeof(NK_UInt32);
+    NK_EXPECT_RETURN_VAL(Need <= Section->Size, -1);
+    Lookup->ChainCnt = (NK_UInt32)((Section->Size - Need) / sizeof(NK_UInt32));
+
+    Offset += 4 * sizeof(NK_UInt32);
+    Lookup->Bloom = Elf_native(Privated, Offset, (NK_UInt64)Lookup->BloomSize * Class->Addrsize, Class->Addrsize, &Class->AddrLayout);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Lookup->Bloom, -1);
+
+    /// 桶与散列链连续存放，一并转换。
+    Offset += (NK_UInt64)Lookup->BloomSize * Class->Addrsize;
+    Lookup->Buckets = Elf_native(Privated, Offset, Section->Size - (Offset - Section->Offset), sizeof(NK_UInt32), &Elf_WordLayout);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Lookup->Buckets, -1);
+    Lookup->Chain = Lookup->Buckets + Lookup->Nbuckets;
+
+    Lookup->Symtab = Elf_locked_symtab(Privated, Sections, Section->Link);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Lookup->Symtab, -1);
+
+    Lookup->Kind = NK_ELF_LOOKUP_GNU;
+
+    return 0;
+}
+
+/**
+ * 由 SHT_HASH 段（即 DT_HASH 指向的表）构建查找表：\n
+ * 桶数、链长之后依次为桶与散列链，均为 4 字节的字，整体转换为本机字节序。表不完整时返回 -1。
+ */
+static NK_Int
+Elf_load_sysv_hash(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index, NK_ElfLookup *Lookup) {
+
+    const NK_ElfSection *Section = &Sections[Index];
+    const NK_UInt32 *Table = NK_Nil;
+
+    NK_EXPECT_RETURN_VAL(Section->Link < Privated->Header.Shnum && SHT_DYNSYM == Sections[Section->Link].Type, -1);
+    NK_EXPECT_RETURN_VAL(Section->Size >= 2 * sizeof(NK_UInt32), -1);
+
+    Table = Elf_native(Privated, Section->Offset, Section->Size, sizeof(NK_UInt32), &Elf_WordLayout);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Table, -1);
+
+    Lookup->Nbuckets = Table[0];
+    Lookup->ChainCnt = Table[1];
+    NK_EXPECT_RETURN_VAL(Lookup->Nbuckets > 0, -1);
+    NK_EXPECT_RETURN_VAL(2 + (NK_UInt64)Lookup->Nbuckets + Lookup->ChainCnt <= Section->Size / sizeof(NK_UInt32), -1);
+
+    Lookup->Buckets = Table + 2;
+    Lookup->Chain = Lookup->Buckets + Lookup->Nbuckets;
+
+    Lookup->Symtab = Elf_locked_symtab(Privated, Sections, Section->Link);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Lookup->Symtab, -1);
+
+    Lookup->Kind = NK_ELF_LOOKUP_SYSV;
+
+    return 0;
+}
+
+/**
+ * 同名符号的优先级：已定义的高于未定义的，非局部的高于局部的。
+ */
+static inline NK_Int
+Elf_symbol_rank(const NK_ElfSymbol *Symbol) {
+
+    return (SHN_UNDEF != Symbol->Shndx ? 2 : 0) + (STB_LOCAL != Symbol->Bind ? 1 : 0);
+}
+
+/**
+ * 为第 @ref Index 段的符号表构建符号名索引，调用者持有 Lock：\n
+ * 槽数按 sh_size / sh_entsize 得到的符号数取不小于其两倍的 2 的幂，线性探测。\n
+ * 符号名散列使用按 8 字节一组计算的 @ref NK_HashWords()，散列的高 32 位存入槽内，\n
+ * 插入与查找时先比较它，只有相同时才比较符号名。\n
+ * 同名符号只保留一个，按 @ref Elf_symbol_rank() 优先，相同时取索引小的；空名符号不入索引。
+ */
+static NK_Int
+Elf_build_index(NK_PrivatedParser *Privated, NK_ElfSection *Sections, NK_UInt32 Index, NK_ElfIndex *Names) {
+
+    const NK_ElfSection *Section = &Sections[Index];
+    const NK_ElfSymtab *Symtab = NK_Nil;
+    NK_ElfSymbol Symbol, Other;
+    NK_UInt64 Cnt = 0;
+    NK_UInt64 Slots = 16;
+    NK_ElfSlot *Table = NK_Nil;
+    NK_Size64 i;
+
+    NK_EXPECT_RETURN_VAL(Section->Entsize == Privated->Class->Symentsize, -1);
+    Cnt = Section->Size / Section->Entsize;
+    NK_EXPECT_RETURN_VAL(Cnt < 0x80000000ULL, -1);
+
+    Symtab = Elf_locked_symtab(Privated, Sections, Index);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Symtab, -1);
+
+    while (Slots < Cnt * 2)
+        Slots <<= 1;
+
+    Table = calloc((size_t)Slots, sizeof(NK_ElfSlot));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Table, -1);
+
+    for (i = 1; i < Symtab->Cnt; i++) {
+
+        NK_UInt64 Hash, Slot;
+        NK_Size Len;
+
+        Privated->Class->symbol(Symtab, i, &Symbol);
+        if ('\0' == Symbol.Name[0]) {
+            continue;
+        }
+
+        Len = strlen(Symbol.Name);
+        Hash = NK_HashWords(Symbol.Name, Len);
+
+        for (Slot = Hash & (Slots - 1); 0 != Table[Slot].Index; Slot = (Slot + 1) & (Slots - 1)) {
+            if ((NK_UInt32)(Hash >> 32) != Table[Slot].Tag) {
+                continue;
+            }
+            Privated->Class->symbol(Symtab, Table[Slot].Index - 1, &Other);
+            if (0 == strcmp(Other.Name, Symbol.Name)) {
+                break;
+            }
+        }
+
+        if (0 != Table[Slot].Index && Elf_symbol_rank(&Symbol) <= Elf_symbol_rank(&Other)) {
+            continue;
+        }
+
+        Table[Slot].Index = (NK_UInt32)i + 1;
+        Table[Slot].Tag = (NK_UInt32)(Hash >> 32);
+    }
+
+    Names->Symtab = Symtab;
+    Names->Slots = Table;
+    Names->Mask = Slots - 1;
+
+    return 0;
+}
+
+/**
+ * 选定并构建按名查找符号的散列表，每个句柄只构建一次，调用者持有 Lock。\n
+ * 依次选用动态符号表的 GNU 散列表、SysV 散列表，两者都没有或都无法使用（如损坏）时为动态符号表构建索引。\n
+ * 没有动态符号表时得到空的查找表。
+ */
+static NK_ElfLookup *
+Elf_build_lookup(NK_PrivatedParser *Privated, NK_ElfSection *Sections) {
+
+    NK_ElfLookup *Lookup = NK_Nil;
+    NK_Int Gnu = -1, Sysv = -1, Dynsym = -1;
+    NK_UInt32 i;
+
+    Lookup = calloc(1, sizeof(NK_ElfLookup));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Lookup, NK_Nil);
+
+    for (i = 0; i < Privated->Header.Shnum; i++) {
+
+        NK_Int *Found = NK_Nil;
+
+        switch (Sections[i].Type)
+        {
+        case SHT_GNU_HASH:  Found = &Gnu;       break;
+        case SHT_HASH:      Found = &Sysv;      break;
+        case SHT_DYNSYM:    Found = &Dynsym;    break;
+        default:                                break;
+        }
+
+        if (NK_Nil != Found && *Found < 0)
+            *Found = (NK_Int)i;
+    }
+
+    if (Gnu >= 0 && 0 == Elf_load_gnu_hash(Privated, Sections, Gnu, Lookup)) {
+        goto _done;
+    }
+    memset(Lookup, 0, sizeof(NK_ElfLookup));
+
+    if (Sysv >= 0 && 0 == Elf_load_sysv_hash(Privated, Sections, Sysv, Lookup)) {
+        goto _done;
+    }
+    memset(Lookup, 0, sizeof(NK_ElfLookup));
+
+    if (Dynsym >= 0 && 0 == Elf_build_index(Privated, Sections, Dynsym, &Lookup->Index)) {
+        Lookup->Symtab = Lookup->Index.Symtab;
+        Lookup->Kind = NK_ELF_LOOKUP_INDEX;
+    }
+
+_done:
+    NK_ELF_PUBLISH(Privated->Lookup, Lookup);
+
+    return Lookup;
+}
+
+/**
+ * GNU 散列表查找：先查布隆过滤器，多数不存在的符号在此返回；\n
+ * 再按桶找到散列链，只比较散列值（忽略最低位）相同的符号名，链上最低位为 1 的项为末项。
+ */
+static NK_Int
+Elf_lookup_gnu(NK_PrivatedParser *Privated, const NK_ElfLookup *Lookup, const NK_Char *Name, NK_ElfSymbol *Symbol) {
+
+    NK_UInt32 Hash = Elf_gnu_hash(Name);
+    NK_UInt32 i;
+
+    if (!Privated->Class->bloom(Lookup, Hash)) {
+        return -1;
+    }
+
+    i = Lookup->Buckets[Hash % Lookup->Nbuckets];
+    if (i < Lookup->Symoffset) {
+        return -1;
+    }
+
+    for (; i - Lookup->Symoffset < Lookup->ChainCnt && i < Lookup->Symtab->Cnt; i++) {
+
+        NK_UInt32 Chain = Lookup->Chain[i - Lookup->Symoffset];
+
+        if ((Hash | 1) == (Chain | 1)) {
+            Privated->Class->symbol(Lookup->Symtab, i, Symbol);
+            if (0 == strcmp(Symbol->Name, Name)) {
+                return 0;
+            }
+        }
+
+        if (Chain & 1) {
+            break;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * SysV 散列表查找：桶给出链首符号索引，散列链按符号索引串联，STN_UNDEF 结束。\n
+ * 链长不超过 nchain，损坏的表不会形成死循环。
+ */
+static NK_Int
+Elf_lookup_sysv(NK_PrivatedParser *Privated, const NK_ElfLookup *Lookup, const NK_Char *Name, NK_ElfSymbol *Symbol) {
+
+    NK_UInt32 i = Lookup->Buckets[Elf_sysv_hash(Name) % Lookup->Nbuckets];
+    NK_UInt32 Steps = 0;
+
+    for (; STN_UNDEF != i && i < Lookup->ChainCnt && i < Lookup->Symtab->Cnt && Steps < Lookup->ChainCnt
+        ; i = Lookup->Chain[i], Steps++) {
+        Privated->Class->symbol(Lookup->Symtab, i, Symbol);
+        if (0 == strcmp(Symbol->Name, Name)) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * 在符号名索引中查找，线性探测至空槽，Tag 相同时才比较符号名。
+ */
+static NK_Int
+Elf_lookup_index(NK_PrivatedParser *Privated, const NK_ElfIndex *Names, const NK_Char *Name, NK_ElfSymbol *Symbol) {
+
+    NK_UInt64 Hash = NK_HashWords(Name, strlen(Name));
+    NK_UInt64 Slot = Hash & Names->Mask;
+
+    for (; 0 != Names->Slots[Slot].Index; Slot = (Slot + 1) & Names->Mask) {
+
+        if ((NK_UInt32)(Hash >> 32) != Names->Slots[Slot].Tag) {
+            continue;
+        }
+
+        Privated->Class->symbol(Names->Symtab, Names->Slots[Slot].Index - 1, Symbol);
+        if (0 == strcmp(Symbol->Name, Name)) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * 构建 .symtab 的符号名索引，调用者持有 Lock。没有 .symtab 时得到空的索引。
+ */
+static NK_ElfIndex *
+Elf_build_statics(NK_PrivatedParser *Privated, NK_ElfSection *Sections) {
+
+    NK_ElfIndex *Names = NK_Nil;
+    NK_UInt32 i;
+
+    Names = calloc(1, sizeof(NK_ElfIndex));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Names, NK_Nil);
+
+    for (i = 0; i < Privated->Header.Shnum; i++) {
+        if (SHT_SYMTAB == Sections[i].Type) {
+            if (0 != Elf_build_index(Privated, Sections, i, Names))
+                memset(Names, 0, sizeof(NK_ElfIndex));
+            break;
+        }
+    }
+
+    NK_ELF_PUBLISH(Privated->Statics, Names);
+
+    return Names;
+}
+
+/**
+ * 按名查找符号，找到时填写 @ref Symbol 并返回 0。\n
+ * 先查动态符号（见 @ref Elf_build_lookup()），查不到时再查 .symtab，\n
+ * 其索引在第一次需要时才构建（见 @ref Elf_build_statics()），只查动态符号的调用者不必为之付出代价。
+ */
+static NK_Int
+Elf_lookup(NK_PrivatedParser *Privated, const NK_Char *Name, NK_ElfSymbol *Symbol) {
+
+    NK_ElfSection *Sections = NK_Nil;
+    NK_ElfLookup *Lookup = NK_ELF_LOAD(Privated->Lookup);
+    NK_ElfIndex *Statics = NK_Nil;
+    NK_Int Ret = -1;
+
+    if (NK_Nil == Lookup) {
+        Sections = Elf_sections(Privated);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Sections, -1);
+        pthread_mutex_lock(&Privated->Lock);
+        Lookup = Privated->Lookup;
+        if (NK_Nil == Lookup) {
+            Lookup = Elf_build_lookup(Privated, Sections);
+        }
+        pthread_mutex_unlock(&Privated->Lock);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Lookup, -1);
+    }
+
+    switch (Lookup->Kind)
+    {
+    case NK_ELF_LOOKUP_GNU:
+        Ret = Elf_lookup_gnu(Privated, Lookup, Name, Symbol);
+        break;
+    case NK_ELF_LOOKUP_SYSV:
+        Ret = Elf_lookup_sysv(Privated, Lookup, Name, Symbol);
+        break;
+    case NK_ELF_LOOKUP_INDEX:
+        Ret = Elf_lookup_index(Privated, &Lookup->Index, Name, Symbol);
+        break;
+    default:
+        break;
+    }
+
+    if (0 == Ret) {
+        return 0;
+    }
+
+    Statics = NK_ELF_LOAD(Privated->Statics);
+    if (NK_Nil == Statics) {
+        Sections = Elf_sections(Privated);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Sections, -1);
+        pthread_mutex_lock(&Privated->Lock);
+        Statics = Privated->Statics;
+        if (NK_Nil == Statics) {
+            Statics = Elf_build_statics(Privated, Sections);
+        }
+        pthread_mutex_unlock(&Privated->Lock);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Statics, -1);
+    }
+
+    if (NK_Nil == Statics->Symtab) {
+        return -1;
+    }
+
+    return Elf_lookup_index(Privated, Statics, Name, Symbol);
+}
+
+/**
+ * 地址索引项的优先级：有长度的高于零长度的，非局部的高于局部的。
+ */
+static inline NK_UInt32
+Elf_extent_rank(const NK_ElfSymbol *Symbol) {
+
+    return (0 != Symbol->Size ? 2 : 0) + (STB_LOCAL != Symbol->Bind ? 1 : 0);
+}
+
+/**
+ * 索引项按地址升序，地址相同时优先级高的在前，再按符号索引。
+ */
+static NK_Int
+Elf_cmp_extent(const NK_Void *a, const NK_Void *b) {
+
+    const NK_ElfExtent *A = a, *B = b;
+
+    if (A->Addr != B->Addr)
+        return A->Addr < B->Addr ? -1 : 1;
+    if (A->Rank != B->Rank)
+        return A->Rank > B->Rank ? -1 : 1;
+    return A->Index < B->Index ? -1 : (A->Index > B->Index ? 1 : 0);
+}
+
+/**
+ * 按中序把有序的索引项填入 Eytzinger 布局的第 @ref K 个位置为根的子树，返回下一个待填的项。
+ */
+static NK_UInt64
+Elf_eytzinger(NK_ElfAddresses *Addresses, NK_UInt64 Next, NK_UInt64 K) {
+
+    if (K <= Addresses->Cnt) {
+        Next = Elf_eytzinger(Addresses, Next, 2 * K);
+        Addresses->Keys[K] = Addresses->Extents[Next].Addr;
+        Addresses->Ranks[K] = (NK_UInt32)Next;
+        Next = Elf_eytzinger(Addresses, Next + 1, 2 * K + 1);
+    }
+
+    return Next;
+}
+
+/**
+ * 构建按地址查找符号的索引，调用者持有 Lock。\n
+ * 索引 .symtab，没有时索引动态符号表，只收录已定义的 STT_FUNC 与 STT_OBJECT 符号。\n
+ * 同一地址只保留一个符号，按 @ref Elf_extent_rank() 优先。\n
+ * 有长度的符号覆盖 [st_value, st_value + st_size)；零长度的符号（如汇编标号）覆盖到下一个符号或所在段的末尾，\n
+ * 且不超出包含它的符号。符号可以嵌套，各项记录包含其起始地址的外层项（Outer），\n
+ * 外层项按栈维护：栈即 Outer 链，出栈沿链后退，不需另外的空间。\n
+ * 起始地址另存为 Eytzinger 布局（按层序存放的隐式二叉树），查找时逐层下降，\n
+ * 前几层集中在少数缓存行内，且可提前预取下几层，见 @ref Elf_locate()。\n
+ * 可重定位文件的符号值是段内偏移，不同段的符号会重叠，得到空的索引。
+ */
+static NK_ElfAddresses *
+Elf_build_addresses(NK_PrivatedParser *Privated, NK_ElfSection *Sections) {
+
+    NK_ElfAddresses *Addresses = NK_Nil;
+    const NK_ElfSymtab *Symtab = NK_Nil;
+    NK_ElfSymbol Symbol;
+    NK_Int Static = -1, Dynamic = -1;
+    NK_UInt64 Cnt = 0;
+    NK_UInt64 Top = 0;
+    NK_Size64 i;
+
+    Addresses = calloc(1, sizeof(NK_ElfAddresses));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Addresses, NK_Nil);
+
+    for (i = 0; i < Privated->Header.Shnum; i++) {
+        if (SHT_SYMTAB == Sections[i].Type && Static < 0)
+            Static = (NK_Int)i;
+        else if (SHT_DYNSYM == Sections[i].Type && Dynamic < 0)
+            Dynamic = (NK_Int)i;
+    }
+
+    if (ET_REL != Privated->Header.Type && (Static >= 0 || Dynamic >= 0)) {
+        Symtab = Elf_locked_symtab(Privated, Sections, Static >= 0 ? Static : Dynamic);
+    }
+
+    if (NK_Nil == Symtab || Symtab->Cnt < 2 || Symtab->Cnt > 0xffffffffULL) {
+        NK_ELF_PUBLISH(Privated->Addresses, Addresses);
+        return Addresses;
+    }
+
+    Addresses->Extents = malloc(sizeof(NK_ElfExtent) * Symtab->Cnt);
+    NK_EXPECT_JUMP(NK_Nil != Addresses->Extents, _fail_exit);
+
+    for (i = 1; i < Symtab->Cnt; i++) {
+
+        NK_ElfExtent *Extent = &Addresses->Extents[Cnt];
+        const NK_ElfSection *Section = NK_Nil;
+
+        Privated->Class->symbol(Symtab, i, &Symbol);
+        if ((STT_FUNC != Symbol.Type && STT_OBJECT != Symbol.Type)
+            || SHN_UNDEF == Symbol.Shndx || Symbol.Shndx >= Privated->Header.Shnum) {
+            continue;
+        }
+
+        /// 零长度的符号先以所在段的末尾为界，排序后再收窄到下一个符号。
+        Section = &Sections[Symbol.Shndx];
+        Extent->Addr = Symbol.Value;
+        Extent->End = Symbol.Value + Symbol.Size;
+        if (0 == Symbol.Size) {
+            Extent->End = Section->Addr + Section->Size > Symbol.Value ? Section->Addr + Section->Size : Symbol.Value;
+        }
+        Extent->Index = (NK_UInt32)i;
+        Extent->Rank = Elf_extent_rank(&Symbol);
+        Cnt++;
+    }
+
+    qsort(Addresses->Extents, Cnt, sizeof(NK_ElfExtent), Elf_cmp_extent);
+
+    /// 同一地址只保留排在最前的项。
+    for (i = 0, Addresses->Cnt = 0; i < Cnt; i++) {
+        if (Addresses->Cnt > 0 && Addresses->Extents[Addresses->Cnt - 1].Addr == Addresses->Extents[i].Addr) {
+            continue;
+        }
+        Addresses->Extents[Addresses->Cnt++] = Addresses->Extents[i];
+    }
+
+    for (i = 0; i + 1 < Addresses->Cnt; i++) {
+        NK_ElfExtent *Extent = &Addresses->Extents[i];
+        if (0 == (Extent->Rank & 2) && Extent->End > Extent[1].Addr)
+            Extent->End = Extent[1].Addr;
+    }
+
+    for (i = 0, Top = 0; i < Addresses->Cnt; i++) {
+
+        NK_ElfExtent *Extent = &Addresses->Extents[i];
+
+        /// 弹出已在本项之前结束的外层项。
+        while (0 != Top && Addresses->Extents[Top - 1].End <= Extent->Addr)
+            Top = Addresses->Extents[Top - 1].Outer;
+
+        Extent->Outer = (NK_UInt32)Top;
+        if (0 != Top && 0 == (Extent->Rank & 2) && Extent->End > Addresses->Extents[Top - 1].End)
+            Extent->End = Addresses->Extents[Top - 1].End;
+
+        Top = i + 1;
+    }
+
+    NK_EXPECT_JUMP(0 == posix_memalign((NK_PVoid *)&Addresses->Keys, 64, sizeof(NK_UInt64) * (Addresses->Cnt + 1)), _fail_exit);
+    Addresses->Ranks = malloc(sizeof(NK_UInt32) * (Addresses->Cnt + 1));
+    NK_EXPECT_JUMP(NK_Nil != Addresses->Ranks, _fail_exit);
+
+    Elf_eytzinger(Addresses, 0, 1);
+    Addresses->Symtab = Symtab;
+    Addresses->Table = Static >= 0 ? Static : Dynamic;
+
+    NK_ELF_PUBLISH(Privated->Addresses, Addresses);
+
+    return Addresses;
+
+_fail_exit:
+    free(Addresses->Extents);
+    free(Addresses->Keys);
+    free(Addresses);
+    return NK_Nil;
+}
+
+/**
+ * 起始地址不大于 @ref Addr 的项共 @ref Rank 个，从其中最后一项起沿 Outer 链找出覆盖 @ref Addr 的项，\n
+ * 即包含 @ref Addr 且起始地址最近的符号；没有时返回 NK_Nil。\n
+ * 包含 @ref Addr 的项都包含最后一项的起始地址，因而都在其 Outer 链上。
+ */
+static const NK_ElfExtent *
+Elf_enclosing(const NK_ElfAddresses *Addresses, NK_UInt64 Rank, NK_UInt64 Addr) {
+
+    const NK_ElfExtent *Extent = NK_Nil;
+
+    while (0 != Rank) {
+        Extent = &Addresses->Extents[Rank - 1];
+        if (Addr < Extent->End) {
+            return Extent;
+        }
+        Rank = Extent->Outer;
+    }
+
+    return NK_Nil;
+}
+
+/**
+ * 找出覆盖 @ref Addr 的索引项，没有时返回 NK_Nil。\n
+ * 在 Eytzinger 布局中逐层下降，每层按比较结果计算子节点下标，循环内没有分支；\n
+ * 8 字节的键每个缓存行容纳 8 个，预取 8k 处即为三层之后的全部子孙。\n
+ * 下降结束后去掉下标末尾的 1 即得到第一个大于 @ref Addr 的键，其前一项为候选，\n
+ * 候选不覆盖 @ref Addr 时再查包含它的外层符号，见 @ref Elf_enclosing()。
+ */
+static const NK_ElfExtent *
+Elf_locate(const NK_ElfAddresses *Addresses, NK_UInt64 Addr) {
+
+    NK_UInt64 K = 1;
+    NK_UInt64 Rank = 0;
+
+    while (K <= Addresses->Cnt) {
+        __builtin_prefetch(Addresses->Keys + 8 * K);
+        K = 2 * K + (Addresses->Keys[K] <= Addr);
+    }
+    K >>= __builtin_ffsll((long long)~K);
+
+    Rank = K ? Addresses->Ranks[K] : Addresses->Cnt;
+
+    return Elf_enclosing(Addresses, Rank, Addr);
+}
+
+/**
+ * 获取按地址查找符号的索引，第一次调用时构建。
+ */
+static const NK_ElfAddresses *
+Elf_addresses(NK_PrivatedParser *Privated) {
+
+    NK_ElfSection *Sections = NK_Nil;
+    NK_ElfAddresses *Addresses = NK_ELF_LOAD(Privated->Addresses);
+
+    if (NK_Nil != Addresses) {
+        return Addresses;
+    }
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Sections, NK_Nil);
+
+    pthread_mutex_lock(&Privated->Lock);
+    Addresses = Privated->Addresses;
+    if (NK_Nil == Addresses) {
+        Addresses = Elf_build_addresses(Privated, Sections);
+    }
+    pthread_mutex_unlock(&Privated->Lock);
+
+    return Addresses;
+}
+
+/**
+ * 本机字节序。
+ */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define NK_ELF_HOST_DATA    (ELFDATA2MSB)
+#else
+#define NK_ELF_HOST_DATA    (ELFDATA2LSB)
+#endif
+
+/**
+ * 按 e_ident[EI_CLASS] 选择解码实现，不支持的类别返回 NK_Nil。
+ */
+static const NK_ElfClass *
+Elf_class(NK_Byte Class) {
+
+    switch (Class)
+    {
+    case ELFCLASS32:
+        return &Elf_Class32;
+    case ELFCLASS64:
+        return &Elf_Class64;
+    default:
+        return NK_Nil;
+    }
+}
+
+/**
+ * 识别文件类别并解码 ELF 头，每个句柄只执行一次。\n
+ * 不是 ELF 文件或类别不支持时失败。
+ */
+static NK_Int
+Elf_identify(NK_PrivatedParser *Privated) {
+
+    NK_PByte Ident = NK_Nil;
+    NK_PVoid Ehdr = NK_Nil;
+    const NK_ElfClass *Class = NK_Nil;
+
+    if (NK_Nil != Privated->Class) {
+        return 0;
+    }
+
+    Ident = Elf_fetch(Privated, 0, EI_NIDENT);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Ident, -1);
+    NK_EXPECT_RETURN_VAL(0 == memcmp(Ident, ELFMAG, SELFMAG), -1);
+    NK_EXPECT_RETURN_VAL(ELFDATA2LSB == Ident[EI_DATA] || ELFDATA2MSB == Ident[EI_DATA], -1);
+
+    Class = Elf_class(Ident[EI_CLASS]);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Class, -1);
+
+    Ehdr = Elf_fetch(Privated, 0, Class->Ehsize);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Ehdr, -1);
+
+    /// 与本机字节序不同的文件先转换 ELF 头。
+    Privated->Swap = (NK_ELF_HOST_DATA != Ident[EI_DATA]) ? NK_True : NK_False;
+    if (Privated->Swap) {
+        NK_Byte Native[NK_ELF_EHDR_MAX];
+        NK_SwapArray(Native, Ehdr, 1, Class->EhdrLayout.Fields, Class->EhdrLayout.Count);
+        Class->ehdr(Native, &Privated->Header);
+    } else {
+        Class->ehdr(Ehdr, &Privated->Header);
+    }
+
+    Privated->Class = Class;
+
+    return 0;
+}
+
+/**
+ * 计算延迟加载时段表的读取窗口。\n
+ * 链接器通常把段表字符串表紧挨着放在段表之前，\n
+ * 因此读取段表时向前多读一个按段数估算的窗口，段表与段名通常一次读取即可得到。\n
+ * 只预告了 header 方法或没有段表时返回 -1，无需读取。
+ */
+static NK_Int
+Elf_shdr_window(NK_PrivatedParser *Privated, NK_ElfRange *Window) {
+
+    const NK_ElfHeader *Header = &Privated->Header;
+    NK_Size64 Ahead = 0;
+
+    if (NK_PARSE_HEADER == (Privated->Flags & NK_PARSE_QUERIES) || 0 == Header->Shnum) {
+        return -1;
+    }
+
+    Ahead = (NK_Size64)Header->Shnum * NK_ELF_SHSTRTAB_AVG;
+    if (Ahead < NK_ELF_SHSTRTAB_AHEAD)
+        Ahead = NK_ELF_SHSTRTAB_AHEAD;
+
+    Window->Offset = Header->Shoff > Ahead ? Header->Shoff - Ahead : 0;
+    Window->Size = Header->Shoff + Elf_shdr_size(Privated) - Window->Offset;
+
+    return 0;
+}
+
+/**
+ * 解析扩展编号，段数或索引超出 16 位的文件在 ELF 头中写入转义值，实际值记录在 0 号段：\n
+ * e_shnum 为 0 且有段表时段数为 sh_size，e_shstrndx 为 SHN_XINDEX 时索引为 sh_link，\n
+ * e_phnum 为 PN_XNUM 时程序头数为 sh_info。没有转义值时不访问段表。
+ */
+static NK_Int
+Elf_extend(NK_PrivatedParser *Privated) {
+
+    NK_ElfHeader *Header = &Privated->Header;
+    NK_PVoid Zero = NK_Nil;
+    NK_ElfShdr Shdr;
+
+    if (!(0 == Header->Shnum && 0 != Header->Shoff) && SHN_XINDEX != Header->Shstrndx && PN_XNUM != Header->Phnum) {
+        return 0;
+    }
+
+    NK_EXPECT_RETURN_VAL(0 != Header->Shoff, -1);
+    Zero = Elf_native(Privated, Header->Shoff, Privated->Class->Shentsize
+        , Privated->Class->Shentsize, &Privated->Class->ShdrLayout);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Zero, -1);
+    Privated->Class->shdr(Zero, 0, &Shdr);
+
+    if (0 == Header->Shnum) {
+        NK_EXPECT_RETURN_VAL(Shdr.Size <= 0xffffffffULL, -1);
+        Header->Shnum = (NK_UInt32)Shdr.Size;
+    }
+    if (SHN_XINDEX == Header->Shstrndx) {
+        Header->Shstrndx = Shdr.Link;
+    }
+    if (PN_XNUM == Header->Phnum) {
+        Header->Phnum = Shdr.Info;
+    }
+
+    return 0;
+}
+
+/**
+ * 延迟加载，仅读取 ELF 头与段表，段内容由 @ref Elf_fetch() 按需读取。\n
+ * 段表连同其前的段名窗口一次读取，见 @ref Elf_shdr_window()。
+ */
+static NK_Int
+Elf_parse_lazy(NK_PrivatedParser *Privated) {
+
+    NK_ElfRange Window;
+
+    Privated->Fd = NK_OpenFile(Privated->Path, &Privated->Size);
+    NK_EXPECT_RETURN_VAL(Privated->Fd >= 0, -1);
+
+    Privated->Source = NK_ELF_SRC_LAZY;
+
+    /// 第一次读取：ELF 头，按最长的 64 位 ELF 头读取。
+    NK_EXPECT_JUMP(NK_Nil != Elf_fetch(Privated, 0
+        , Privated->Size < NK_ELF_EHDR_MAX ? Privated->Size : NK_ELF_EHDR_MAX), _fail_exit);
+    NK_EXPECT_JUMP(0 == Elf_identify(Privated), _fail_exit);
+
+    /// 使用扩展编号的文件需先读 0 号段。
+    NK_EXPECT_JUMP(0 == Elf_extend(Privated), _fail_exit);
+
+    /// 第二次读取：段表及其之前的段名窗口。
+    if (0 != Elf_shdr_window(Privated, &Window)) {
+        return 0;
+    }
+
+    if (NK_Nil == Elf_fetch(Privated, Window.Offset, Window.Size)) {
+        NK_EXPECT_JUMP(NK_Nil != Elf_shdr_table(Privated), _fail_exit);
+    }
+
+    return 0;
+
+_fail_exit:
+    Elf_drop_regions(&Privated->Regions);
+    Elf_drop_regions(&Privated->Native);
+    NK_CloseFile(Privated->Fd);
+    Privated->Fd = -1;
+    Privated->Source = NK_ELF_SRC_NONE;
+    Privated->Class = NK_Nil;
+    return -1;
+}
+
+/**
+ * NK_This 指针定义，\n
+ * 定义以下为模块 API 接口实现。
+ */
+#define NK_This NK_Parser * const Public
+
+#define NK_Log ("Parser")
+
+static NK_Int
+Elf_cmp_range(const NK_Void *a, const NK_Void *b) {
+
+    const NK_ElfRange *A = a, *B = b;
+    return A->Offset < B->Offset ? -1 : (A->Offset > B->Offset ? 1 : 0);
+}
+
+/**
+ * 选出输出方法需要的区间：段表字符串表、符号表及其字符串表与扩展段索引表、程序头表，\n
+ * 按文件偏移排序并合并重叠部分，@ref Table 为段表，@ref Ranges 至少容纳 段数 x 2 + 1 项。\n
+ * 返回区间数。
+ */
+static NK_Int
+Elf_select_ranges(NK_PrivatedParser *Privated, const NK_Void *Table, NK_ElfRange *Ranges) {
+
+    const NK_ElfHeader *Header = &Privated->Header;
+    NK_Int Cnt = 0;
+    NK_Int Merged = 0;
+    NK_Int i;
+
+    for (i = 0; i < (NK_Int)Header->Shnum; i++) {
+
+        NK_ElfShdr Shdr[2];
+        NK_Int Used = 0;
+
+        Privated->Class->shdr(Table, i, &Shdr[0]);
+
+        if ((NK_UInt32)i == Header->Shstrndx || SHT_SYMTAB_SHNDX == Shdr[0].Type) {
+            Used = 1;
+        } else if (SHT_SYMTAB == Shdr[0].Type || SHT_DYNSYM == Shdr[0].Type) {
+            Used = 1;
+            if (Shdr[0].Link < Header->Shnum) {
+                Privated->Class->shdr(Table, Shdr[0].Link, &Shdr[1]);
+                Used = 2;
+            }
+        }
+
+        NK_Int ii;
+        for (ii = 0; ii < Used; ii++) {
+            if (SHT_NOBITS == Shdr[ii].Type || 0 == Shdr[ii].Size) {
+                continue;
+            }
+            Ranges[Cnt].Offset = Shdr[ii].Offset;
+            Ranges[Cnt].Size = Shdr[ii].Size;
+            Cnt++;
+        }
+    }
+
+    /// 程序头表位于 ELF 头之后时保留。
+    if (Header->Phnum > 0 && Header->Phoff >= Privated->Class->Ehsize) {
+        Ranges[Cnt].Offset = Header->Phoff;
+        Ranges[Cnt].Size = (NK_Size64)Header->Phnum * Privated->Class->Phentsize;
+        Cnt++;
+    }
+
+    qsort(Ranges, Cnt, sizeof(NK_ElfRange), Elf_cmp_range);
+
+    /// 合并重叠区间。
+    for (i = 0; i < Cnt; i++) {
+        if (Merged > 0 && Ranges[i].Offset <= Ranges[Merged - 1].Offset + Ranges[Merged - 1].Size) {
+            NK_Size64 End = Ranges[i].Offset + Ranges[i].Size;
+            if (End > Ranges[Merged - 1].Offset + Ranges[Merged - 1].Size)
+                Ranges[Merged - 1].Size = End - Ranges[Merged - 1].Offset;
+        } else {
+            Ranges[Merged++] = Ranges[i];
+        }
+    }
+
+    return Merged;
+}
+
+/**
+ * 流式读取，适用于标准输入、管道等不可定位的源。\n
+ * 按文件顺序读取：先读 ELF 头，再读到段表，\n
+ * 段表之前的数据暂存为数据块，段表读入后仅保留段表字符串表、符号表及其字符串表等需要的段，\n
+ * 其余数据块随即释放，段表之后的无关数据直接跳过。\n
+ * 段表通常位于文件末尾，暂存的数据块合计 e_shoff 字节，峰值内存约为文件长度。
+ */
+static NK_Int
+Elf_parse_stream(NK_PrivatedParser *Privated) {
+
+    NK_ElfRegion *Spool = NK_Nil;
+    NK_ElfRegion *Region = NK_Nil;
+    NK_ElfRegion *Zero = NK_Nil;
+    NK_ElfRegion *Held = NK_Nil;
+    NK_ElfRange *Ranges = NK_Nil;
+    NK_PByte Scratch = NK_Nil;
+    const NK_ElfHeader *Header = &Privated->Header;
+    const NK_ElfClass *Class = NK_Nil;
+    NK_PVoid Table = NK_Nil;
+    NK_Size64 Pos = 0;
+    NK_Int Cnt = 0;
+    NK_Int i;
+
+    Privated->Fd = NK_OpenStream(Privated->Path);
+    NK_EXPECT_RETURN_VAL(Privated->Fd >= 0, -1);
+
+    Privated->Source = NK_ELF_SRC_STREAM;
+
+    /// ELF 头，先读 e_ident 确定类别，再读其余部分。
+    Region = Elf_new_region(0, NK_ELF_EHDR_MAX);
+    NK_EXPECT_JUMP(NK_Nil != Region, _fail_exit);
+    Region->Next = Privated->Regions;
+    Privated->Regions = Region;
+    NK_EXPECT_JUMP(EI_NIDENT == NK_ReadStream(Privated->Fd, Region->Data, EI_NIDENT), _fail_exit);
+    Class = Elf_class(Region->Data[EI_CLASS]);
+    NK_EXPECT_JUMP(NK_Nil != Class, _fail_exit);
+    Region->Size = Class->Ehsize;
+    NK_EXPECT_JUMP((NK_SSize64)(Region->Size - EI_NIDENT)
+        == NK_ReadStream(Privated->Fd, Region->Data + EI_NIDENT, Region->Size - EI_NIDENT), _fail_exit);
+    Pos = Region->Size;
+
+    /// 流的长度未知，ELF 头范围内的访问均有效。
+    Privated->Size = Pos;
+    NK_EXPECT_JUMP(0 == Elf_identify(Privated), _fail_exit);
+
+    if (0 == Header->Shoff) {
+        goto _done;
+    }
+    NK_EXPECT_JUMP(Header->Shoff >= Pos, _fail_exit);
+
+    /// 段表之前的数据，此时尚不知道哪些段会被用到，暂存为数据块。
+    while (Pos < Header->Shoff) {
+
+        NK_Size64 Size = Header->Shoff - Pos;
+        if (Size > NK_ELF_STREAM_CHUNK)
+            Size = NK_ELF_STREAM_CHUNK;
+
+        Region = Elf_new_region(Pos, Size);
+        NK_EXPECT_JUMP(NK_Nil != Region, _fail_exit);
+        Region->Next = Spool;
+        Spool = Region;
+        NK_EXPECT_JUMP((NK_SSize64)Size == NK_ReadStream(Privated->Fd, Region->Data, Size), _fail_exit);
+        Pos += Size;
+    }
+
+    /// 0 号段，扩展编号的段数与段表字符串表索引记录在其中。
+    Zero = Elf_new_region(Pos, Class->Shentsize);
+    NK_EXPECT_JUMP(NK_Nil != Zero, _fail_exit);
+    Zero->Next = Privated->Regions;
+    Privated->Regions = Zero;
+    NK_EXPECT_JUMP((NK_SSize64)Zero->Size == NK_ReadStream(Privated->Fd, Zero->Data, Zero->Size), _fail_exit);
+    Privated->Size = Pos + Zero->Size;
+    NK_EXPECT_JUMP(0 == Elf_extend(Privated), _fail_exit);
+
+    if (0 == Header->Shnum) {
+        Pos += Zero->Size;
+        goto _done;
+    }
+    NK_EXPECT_JUMP(Header->Shstrndx < Header->Shnum, _fail_exit);
+
+    /// 段表，其余各项接在 0 号段之后。
+    Region = Elf_new_region(Pos, Elf_shdr_size(Privated));
+    NK_EXPECT_JUMP(NK_Nil != Region, _fail_exit);
+    Region->Next = Privated->Regions;
+    Privated->Regions = Region;
+    memcpy(Region->Data, Zero->Data, (size_t)Zero->Size);
+    NK_EXPECT_JUMP((NK_SSize64)(Region->Size - Zero->Size)
+        == NK_ReadStream(Privated->Fd, Region->Data + Zero->Size, Region->Size - Zero->Size), _fail_exit);
+    Pos += Region->Size;
+
+    /// 选出需要保留的区间。
+    Privated->Size = Pos;
+    Table = Elf_shdr_table(Privated);
+    NK_EXPECT_JUMP(NK_Nil != Table, _fail_exit);
+    Ranges = calloc((NK_Size)Header->Shnum * 2 + 1, sizeof(NK_ElfRange));
+    NK_EXPECT_JUMP(NK_Nil != Ranges, _fail_exit);
+
+    /// 区间按文件顺序排列，之后只需顺序前进。
+    Cnt = Elf_select_ranges(Privated, Table, Ranges);
+
+    Scratch = malloc(NK_ELF_STREAM_CHUNK);
+    NK_EXPECT_JUMP(NK_Nil != Scratch, _fail_exit);
+
+    /// 已保留的 ELF 头与段表，与数据块一起覆盖了 [0, Pos)。
+    Held = Privated->Regions;
+
+    for (i = 0; i < Cnt; i++) {
+
+        NK_Size64 Offset = Ranges[i].Offset;
+        NK_Size64 End = Ranges[i].Offset + Ranges[i].Size;
+        NK_Size64 Copied;
+
+        Region = Elf_new_region(Offset, End - Offset);
+        NK_EXPECT_JUMP(NK_Nil != Region, _fail_exit);
+        Region->Next = Privated->Regions;
+        Privated->Regions = Region;
+
+        /// 已读过的部分从数据块以及 ELF 头、段表拷贝，畸形文件中选中的区间可能与 ELF 头或段表重叠。
+        NK_ElfRegion *Lists[2] = {Spool, Held};
+        NK_ElfRegion *Chunk;
+        NK_Int ii;
+        for (ii = 0; ii < 2; ii++) {
+            for (Chunk = Lists[ii]; NK_Nil != Chunk; Chunk = Chunk->Next) {
+                NK_Size64 From = Offset > Chunk->Offset ? Offset : Chunk->Offset;
+                NK_Size64 To = End < Chunk->Offset + Chunk->Size ? End : Chunk->Offset + Chunk->Size;
+                if (From < To) {
+                    memcpy(Region->Data + (From - Offset), Chunk->Data + (From - Chunk->Offset), To - From);
+                }
+            }
+        }
+
+        if (End <= Pos) {
+            continue;
+        }
+
+        /// 跳过无关数据。
+        while (Pos < Offset) {
+            NK_Size64 Size = Offset - Pos;
+            if (Size > NK_ELF_STREAM_CHUNK)
+                Size = NK_ELF_STREAM_CHUNK;
+            NK_EXPECT_JUMP((NK_SSize64)Size == NK_ReadStream(Privated->Fd, Scratch, Size), _fail_exit);
+            Pos += Size;
+        }
+
+        Copied = Pos - Offset;
+        NK_EXPECT_JUMP((NK_SSize64)(End - Pos) == NK_ReadStream(Privated->Fd, Region->Data + Copied, End - Pos), _fail_exit);
+        Pos = End;
+    }
+
+_done:
+    Elf_drop_regions(&Spool);
+    free(Ranges);
+    free(Scratch);
+
+    /// 流已不再需要。
+    NK_CloseFile(Privated->Fd);
+    Privated->Fd = -1;
+    Privated->Size = Pos;
+
+    return 0;
+
+_fail_exit:
+    Elf_drop_regions(&Spool);
+    free(Ranges);
+    free(Scratch);
+
+    Elf_drop_regions(&Privated->Regions);
+    Elf_drop_regions(&Privated->Native);
+    NK_CloseFile(Privated->Fd);
+    Privated->Fd = -1;
+    Privated->Source = NK_ELF_SRC_NONE;
+    Privated->Size = 0;
+    Privated->Class = NK_Nil;
+    return -1;
+}
+
+/**
+ * 缓存文件路径，以源文件 (dev, inode) 命名。
+ */
+static NK_Int
+Elf_cache_path(const NK_FileStat *Stat, NK_PChar Path, NK_Size Size) {
+
+    NK_Int Len = snprintf(Path, Size, "%s/%016llx-%016llx.nkc", Elf_CacheDir
+        , (unsigned long long)Stat->Dev, (unsigned long long)Stat->Ino);
+    return (Len > 0 && (NK_Size)Len < Size) ? 0 : -1;
+}
+
+/**
+ * 尝试从解析缓存加载。\n
+ * 命中时 ELF 头、段描述表与段名直接取自缓存文件映射，源文件只读取头部用于校验，\n
+ * 跨字节序的文件已转换的区间挂到 Native 上；源文件本身映射或按需读取，与 @ref Elf_load() 一致。
+ */
+static NK_Int
+Elf_cache_load(NK_PrivatedParser *Privated) {
+
+    NK_FileStat Stat;
+    NK_Char Path[512];
+    NK_PChar Map = NK_Nil;
+    NK_SSize64 MapSize = 0;
+    NK_SSize64 SrcSize = 0;
+    NK_ElfCacheHeader *Header = NK_Nil;
+    NK_ElfCacheEntry *Entry = NK_Nil;
+    NK_ElfSection *Sections = NK_Nil;
+    const NK_Char *Names = NK_Nil;
+    const NK_Byte *Head = NK_Nil;
+    NK_Size64 HeadSize = 0;
+    NK_UInt64 Shnum = 0;
+    NK_UInt64 i;
+
+    NK_EXPECT_RETURN_VAL('\0' != Elf_CacheDir[0], -1);
+    NK_EXPECT_RETURN_VAL(0 == NK_StatFile(Privated->Path, &Stat), -1);
+    NK_EXPECT_RETURN_VAL(0 == Elf_cache_path(&Stat, Path, sizeof(Path)), -1);
+
+    MapSize = NK_MapFile2Buffer(Path, &Map);
+    NK_EXPECT_RETURN_VAL(MapSize > 0, -1);
+
+    /// 校验缓存文件。
+    Header = (NK_ElfCacheHeader *)Map;
+    NK_EXPECT_JUMP((NK_Size64)MapSize >= sizeof(NK_ElfCacheHeader), _fail_exit);
+    NK_EXPECT_JUMP(NK_ELF_CACHE_MAGIC == Header->Magic && NK_ELF_CACHE_VERSION == Header->Version, _fail_exit);
+    NK_EXPECT_JUMP(sizeof(NK_ElfSection) == Header->Entsize && NK_Nil != Elf_class(Header->Class), _fail_exit);
+    NK_EXPECT_JUMP(0 == memcmp(&Header->Stat, &Stat, sizeof(NK_FileStat)), _fail_exit);
+
+    Shnum = Header->Header.Shnum;
+    NK_EXPECT_JUMP(0 == Header->Sections % 8 && Header->Sections <= (NK_Size64)MapSize
+        && Shnum + 1 <= ((NK_Size64)MapSize - Header->Sections) / sizeof(NK_ElfSection), _fail_exit);
+    NK_EXPECT_JUMP(Header->Names <= (NK_Size64)MapSize && Header->NamesSize <= (NK_Size64)MapSize - Header->Names, _fail_exit);
+    NK_EXPECT_JUMP(0 == Header->Entries % 8 && Header->Entries <= (NK_Size64)MapSize
+        && Header->Count <= ((NK_Size64)MapSize - Header->Entries) / sizeof(NK_ElfCacheEntry), _fail_exit);
+
+    Sections = (NK_ElfSection *)(Map + Header->Sections);
+    Names = Map + Header->Names;
+    Entry = (NK_ElfCacheEntry *)(Map + Header->Entries);
+
+    /// 段名与段索引越界的缓存视为损坏，段描述的其余内容在写入前已校验。
+    for (i = 0; i < Shnum; i++) {
+        NK_EXPECT_JUMP(0 == Sections[i].NameLen || ((NK_UInt64)Sections[i].Name + Sections[i].NameLen < Header->NamesSize
+            && '\0' == Names[Sections[i].Name + Sections[i].NameLen]), _fail_exit);
+        NK_EXPECT_JUMP(Sections[i].Xindex < Shnum, _fail_exit);
+    }
+    for (i = 0; i < Header->Count; i++) {
+        NK_EXPECT_JUMP(Entry[i].Data <= (NK_Size64)MapSize && Entry[i].Size <= (NK_Size64)MapSize - Entry[i].Data, _fail_exit);
+        NK_EXPECT_JUMP(Entry[i].Offset <= Stat.Size && Entry[i].Size <= Stat.Size - Entry[i].Offset, _fail_exit);
+    }
+
+    /// 打开源文件，不读取内容。
+    if (!(Privated->Flags & NK_PARSE_LAZY)) {
+        SrcSize = NK_MapFile2Buffer(Privated->Path, (NK_PChar *)(&Privated->Src));
+    }
+    if (SrcSize > 0) {
+        Privated->Size = (NK_Size64)SrcSize;
+        Privated->Source = NK_ELF_SRC_MAP;
+        Elf_advise(Privated, 0, Privated->Size, NK_ADVICE_RANDOM);
+    } else {
+        Privated->Src = NK_Nil;
+        Privated->Fd = NK_OpenFile(Privated->Path, &Privated->Size);
+        NK_EXPECT_JUMP(Privated->Fd >= 0, _fail_exit);
+        Privated->Source = NK_ELF_SRC_LAZY;
+    }
+    NK_EXPECT_JUMP(Privated->Size == Stat.Size, _fail_exit);
+
+    /// 校验源文件头部，防止修改时间未变的改写。
+    HeadSize = Stat.Size < NK_ELF_CACHE_HASHED ? Stat.Size : NK_ELF_CACHE_HASHED;
+    Head = Elf_fetch(Privated, 0, HeadSize);
+    NK_EXPECT_JUMP(NK_Nil != Head && Header->Hash == NK_Hash64((NK_PVoid)Head, HeadSize), _fail_exit);
+
+    /// 已转换的区间直接引用映射。
+    for (i = 0; i < Header->Count; i++) {
+        NK_ElfRegion *Region = Elf_new_region(Entry[i].Offset, 0);
+        NK_EXPECT_JUMP(NK_Nil != Region, _fail_exit);
+        Region->Size = Entry[i].Size;
+        Region->Data = (NK_PByte)Map + Entry[i].Data;
+        Region->Next = Privated->Native;
+        Privated->Native = Region;
+    }
+
+    Privated->Symtabs = calloc((NK_Size)Shnum + 1, sizeof(NK_ElfSymtab *));
+    NK_EXPECT_JUMP(NK_Nil != Privated->Symtabs, _fail_exit);
+
+    Privated->Class = Elf_class(Header->Class);
+    Privated->Swap = Header->Swap ? NK_True : NK_False;
+    Privated->Valid = Header->Valid ? NK_True : NK_False;
+    Privated->Header = Header->Header;
+    Privated->Shstrtab = Names;
+    Privated->Sections = Sections;
+    Privated->Cache = Map;
+    Privated->CacheSize = (NK_Size64)MapSize;
+
+    return 0;
+
+_fail_exit:
+    free(Privated->Symtabs);
+    Privated->Symtabs = NK_Nil;
+    Elf_drop_regions(&Privated->Regions);
+    Elf_drop_regions(&Privated->Native);
+    if (NK_ELF_SRC_MAP == Privated->Source)
+        NK_UnmapBuffer(Privated->Src, Privated->Size);
+    if (Privated->Fd >= 0)
+        NK_CloseFile(Privated->Fd);
+    Privated->Src = NK_Nil;
+    Privated->Fd = -1;
+    Privated->Size = 0;
+    Privated->Source = NK_ELF_SRC_NONE;
+    NK_UnmapBuffer(Map, (NK_Size64)MapSize);
+    return -1;
+}
+
+/**
+ * 将解码结果写入解析缓存，失败不影响解析结果。\n
+ * 先打开全部符号表与按名查找的散列表，扫描结果与转换后的区间随之就绪，\n
+ * 段描述表连同扫描结果、段名与已转换的区间按 @ref NK_ELF_CACHE_VERSION 的格式写出。
+ */
+static NK_Int
+Elf_cache_store(NK_PrivatedParser *Privated) {
+
+    NK_FileStat Stat;
+    NK_Char Path[512];
+    NK_ElfSection *Sections = NK_Nil;
+    NK_ElfSection *Cached = NK_Nil;
+    NK_ElfRegion *Native = NK_Nil;
+    NK_ElfRegion *Region = NK_Nil;
+    NK_PByte Buffer = NK_Nil;
+    NK_ElfCacheHeader *Header = NK_Nil;
+    NK_ElfCacheEntry *Entry = NK_Nil;
+    const NK_Byte *Head = NK_Nil;
+    NK_UInt64 Shnum = Privated->Header.Shnum;
+    NK_UInt64 NamesSize = 0;
+    NK_UInt64 Count = 0;
+    NK_Size64 Size = 0;
+    NK_Size64 Pos = 0;
+    NK_Size64 HeadSize = 0;
+    NK_Int Ret = -1;
+    NK_UInt64 i;
+
+    NK_EXPECT_RETURN_VAL('\0' != Elf_CacheDir[0], -1);
+    NK_EXPECT_RETURN_VAL(0 == NK_StatFile(Privated->Path, &Stat), -1);
+    NK_EXPECT_RETURN_VAL(Stat.Size == Privated->Size, -1);
+    NK_EXPECT_RETURN_VAL(0 == Elf_cache_path(&Stat, Path, sizeof(Path)), -1);
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Sections, -1);
+
+    /// 打开符号表与散列表，跨字节序时同时得到转换后的区间。
+    for (i = 0; i < Shnum; i++) {
+        if (SHT_SYMTAB == Sections[i].Type || SHT_DYNSYM == Sections[i].Type) {
+            Elf_open_symtab(Privated, Sections, (NK_UInt32)i);
+        }
+    }
+    if (Privated->Swap) {
+        pthread_mutex_lock(&Privated->Lock);
+        if (NK_Nil == Privated->Lookup) {
+            Elf_build_lookup(Privated, Sections);
+        }
+        pthread_mutex_unlock(&Privated->Lock);
+    }
+
+    /// 段名池按段顺序存放各段名，以 '\0' 结尾。
+    for (i = 0; i < Shnum; i++) {
+        NamesSize += (NK_UInt64)Sections[i].NameLen + 1;
+    }
+    Native = NK_ELF_LOAD(Privated->Native);
+    for (Region = Native; NK_Nil != Region; Region = Region->Next) {
+        Count++;
+    }
+
+    Size = sizeof(NK_ElfCacheHeader) + (Shnum + 1) * sizeof(NK_ElfSection) + ((NamesSize + 7) & ~7ULL)
+        + Count * sizeof(NK_ElfCacheEntry);
+    for (Region = Native; NK_Nil != Region; Region = Region->Next) {
+        Size += (Region->Size + 7) & ~7ULL;
+    }
+
+    Buffer = calloc(1, (size_t)Size);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Buffer, -1);
+
+    Header = (NK_ElfCacheHeader *)Buffer;
+    Header->Magic = NK_ELF_CACHE_MAGIC;
+    Header->Version = NK_ELF_CACHE_VERSION;
+    Header->Entsize = sizeof(NK_ElfSection);
+    Header->Class = Privated->Class->Class;
+    Header->Swap = Privated->Swap ? 1 : 0;
+    Header->Valid = Privated->Valid ? 1 : 0;
+    Header->Stat = Stat;
+    Header->Header = Privated->Header;
+
+    HeadSize = Stat.Size < NK_ELF_CACHE_HASHED ? Stat.Size : NK_ELF_CACHE_HASHED;
+    Head = Elf_fetch(Privated, 0, HeadSize);
+    NK_EXPECT_JUMP(NK_Nil != Head, _exit);
+    Header->Hash = NK_Hash64((NK_PVoid)Head, HeadSize);
+
+    /// 段描述表，段名改为段名池内的偏移，记录符号表的扫描结果。
+    Pos = sizeof(NK_ElfCacheHeader);
+    Header->Sections = Pos;
+    Cached = (NK_ElfSection *)(Buffer + Pos);
+    memcpy(Cached, Sections, (size_t)(Shnum * sizeof(NK_ElfSection)));
+    Pos += (Shnum + 1) * sizeof(NK_ElfSection);
+
+    Header->Names = Pos;
+    Header->NamesSize = NamesSize;
+    for (i = 0; i < Shnum; i++) {
+        const NK_ElfSymtab *Symtab = NK_ELF_LOAD(Privated->Symtabs[i]);
+        memcpy(Buffer + Pos, Elf_section_name(Privated, &Sections[i]), Sections[i].NameLen);
+        Cached[i].Name = (NK_UInt32)(Pos - Header->Names);
+        Pos += Sections[i].NameLen + 1;
+        if (NK_Nil != Symtab && Symtab->Checked) {
+            Cached[i].Checks |= NK_ELF_CHECK_SYMBOLS;
+        }
+    }
+    Pos = (Pos + 7) & ~7ULL;
+
+    /// 已转换的区间。
+    Header->Count = Count;
+    Header->Entries = Pos;
+    Entry = (NK_ElfCacheEntry *)(Buffer + Pos);
+    Pos += Count * sizeof(NK_ElfCacheEntry);
+    for (Region = Native, i = 0; NK_Nil != Region; Region = Region->Next, i++) {
+        Entry[i].Offset = Region->Offset;
+        Entry[i].Size = Region->Size;
+        Entry[i].Data = Pos;
+        memcpy(Buffer + Pos, Region->Data, (size_t)Region->Size);
+        Pos += (Region->Size + 7) & ~7ULL;
+    }
+
+    Ret = NK_WriteFileAtomic(Path, Buffer, Size);
+
+_exit:
+    free(Buffer);
+    return Ret;
+}
+
+/**
+ * 是否只预告了 header/section/segments 方法，这些方法只需 ELF 头、段表与程序头表。
+ */
+static inline NK_Boolean
+Elf_layout_only(NK_UInt32 Flags) {
+
+    return (0 != (Flags & NK_PARSE_QUERIES)
+        && 0 == (Flags & NK_PARSE_QUERIES & ~(NK_PARSE_HEADER | NK_PARSE_SECTION | NK_PARSE_SEGMENT))) ? NK_True : NK_False;
+}
+
+/**
+ * 从文件加载：依次尝试延迟加载、只读映射、分段读取、缓冲读取与流式读取。
+ */
+static NK_Int
+Elf_load(NK_PrivatedParser *Privated) {
+
+    NK_SSize64 Size = 0;
+
+    /// 延迟加载，不可 pread 的源退回到整体加载。
+    /// 预告只调用 header/section/segments 时同样走延迟加载，只读取少量小块。
+    if ((Privated->Flags & NK_PARSE_LAZY) || Elf_layout_only(Privated->Flags)) {
+        if (0 == Elf_parse_lazy(Privated)) {
+            return 0;
+        }
+    }
+
+    /// 优先只读映射，直接从页缓存访问。
+    Size = NK_MapFile2Buffer(Privated->Path, (NK_PChar *)(&Privated->Src));
+    if (Size > 0) {
+        Privated->Size = (NK_Size64)Size;
+        Privated->Source = NK_ELF_SRC_MAP;
+        /// 各方法只访问少量区间，关闭整体预读，需要的区间由方法单独提示。
+        Elf_advise(Privated, 0, Privated->Size, NK_ADVICE_RANDOM);
+        return 0;
+    }
+
+    /// 无法整体映射（如超出 32 位地址空间）的普通文件按需分段读取，
+    /// 避免为整个文件申请一块连续内存。
+    Privated->Src = NK_Nil;
+    if (0 == Elf_parse_lazy(Privated)) {
+        return 0;
+    }
+
+    /// 不可映射的源退回到缓冲读取。
+    Size = NK_ReadFile2Buffer(Privated->Path, (NK_PChar *)(&Privated->Src));
+    if (Size > 0 && NK_Nil != Privated->Src) {
+        Privated->Size = (NK_Size64)Size;
+        Privated->Source = NK_ELF_SRC_HEAP;
+        return 0;
+    }
+
+    /// 管道、/proc 等无法获取长度的源按流读取。
+    Privated->Src = NK_Nil;
+    Privated->Size = 0;
+    return Elf_parse_stream(Privated);
+}
+
+/**
+ * parse start。
+ */
+static NK_Int
+Elf_parse(NK_This) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 重复解析。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_ELF_SRC_NONE == Privated->Source, -1);
+
+    NK_Boolean Store = NK_False;
+
+    if (NK_Nil != Privated->Src) {
+        /// 调用者提供的内存无需任何读取。
+        Privated->Source = NK_ELF_SRC_MEMORY;
+    } else if (0 == strcmp(Privated->Path, "-")) {
+        /// 标准输入只能顺序读取。
+        NK_EXPECT_VERBOSE_RETURN_VAL(0 == Elf_parse_stream(Privated), -1);
+    } else if ((Privated->Flags & NK_PARSE_CACHE) && 0 == Elf_cache_load(Privated)) {
+        /// 命中解析缓存时 ELF 头与段描述表已就绪，无需识别与解码。
+        return 0;
+    } else {
+        NK_EXPECT_VERBOSE_RETURN_VAL(0 == Elf_load(Privated), -1);
+        /// 只预告 header/section/segments 时不写缓存：写缓存需读取全部符号表，
+        /// 而这些方法本身至多读取两次。
+        Store = ((Privated->Flags & NK_PARSE_CACHE) && !Elf_layout_only(Privated->Flags)) ? NK_True : NK_False;
+    }
+
+    /// 确定文件类别，之后各方法直接使用对应类别的实现。
+    NK_EXPECT_VERBOSE_RETURN_VAL(0 == Elf_identify(Privated), -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(0 == Elf_extend(Privated), -1);
+
+    /// 构建段描述表，只预告 header 方法时推迟到首次使用，不读取段表。
+    if (NK_PARSE_HEADER != (Privated->Flags & NK_PARSE_QUERIES)) {
+        Elf_sections(Privated);
+    }
+
+    /// 写入解析缓存，失败不影响本次解析。
+    if (Store) {
+        Elf_cache_store(Privated);
+    }
+
+    return 0;
+}
+
+/**
+ * dump header。
+ */
+static NK_Int
+Elf_header(NK_This) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    NKLOG(NK_Log, NKL_Alert, "ELF header begin");
+
+    NK_Int i;
+    const NK_ElfHeader *Ehdr = &Privated->Header;
+
+    TRACE("ELF Headers:\n");
+
+    /**
+     * Magic number and other info
+     */
+    for (i = 0; i < EI_NIDENT; i++) {
+
+        if (0 == i)
+            TRACE("  Magic:\t%02hhx ", Ehdr->Ident[i]);
+        else if ((i + 1) == EI_NIDENT)
+            TRACE("%02hhx\r\n", Ehdr->Ident[i]);
+        else
+            TRACE("%02hhx ", Ehdr->Ident[i]);
+    }
+
+    switch (Ehdr->Ident[EI_CLASS])
+    {
+    case ELFCLASS32:
+        TRACE("  Class:\tELF32\r\n"); break;
+    case ELFCLASS64:
+        TRACE("  Class:\tELF64\r\n"); break;
+    default:
+        TRACE("  Class:\tInvalid class\r\n"); break;
+    }
+
+    switch (Ehdr->Ident[EI_DATA])
+    {
+    case ELFDATA2LSB:
+        TRACE("  Date:t\t1's complement, little endian\r\n"); break;
+    case ELFDATA2MSB:
+        TRACE("  Date:t\t2's complement, big endian\r\n"); break;
+    default:
+        TRACE("  Date:\t\tInvalid data encoding\r\n"); break;
+    }
+
+    TRACE("  Version:\t%d\r\n", Ehdr->Ident[EI_VERSION]);
+
+    switch (Ehdr->Ident[EI_OSABI])
+    {
+    case ELFOSABI_NONE:
+        TRACE("  OS/ABI:\tUNIX System V ABI\r\n"); break;
+    default:
+        TRACE("  OS/ABI:\tUnknow\r\n"); break;
+    }
+
+    TRACE("  ABI Version:\t%d\r\n", Ehdr->Ident[EI_ABIVERSION]);
+
+    /**
+     * Object file type
+     */
+    switch (Ehdr->Type)
+    {
+    case ET_REL:
+        TRACE("  Type:\t\tREL (Relocatable file)\r\n"); break;
+    case ET_EXEC:
+        TRACE("  Type:\t\tEXEC (Executable file)\r\n"); break;
+    case ET_DYN:
+        TRACE("  Type:\t\tDYN (Shared object file)\r\n"); break;
+    case ET_CORE:
+        TRACE("  Type:\t\tCORE (Core file)\r\n"); break;
+    default:
+        TRACE("  Type:\t\tNONE (No file type)\r\n"); break;
+    }
+
+    /**
+     * Architecture
+     */
+    TRACE("  Machine:\t%d\r\n", Ehdr->Machine);
+
+    /**
+     * Object file version
+     */
+    TRACE("  Version:\t%d\r\n", Ehdr->Version);
+
+    /**
+     * Entry point virtual address
+     */
+    TRACE("  Entry Point address:\t0x%llx\r\n", (unsigned long long)Ehdr->Entry);
+
+    /**
+     * Program header table file offset
+     */
+    TRACE("  Start of program headers\t%llu (bytes into file)\r\n", (unsigned long long)Ehdr->Phoff);
+
+    /**
+     * Section header table file offset
+     */
+    TRACE("  Start of section headers:\t%llu (bytes into file)\r\n", (unsigned long long)Ehdr->Shoff);
+
+    /**
+     * Processor-specific flags
+     */
+    TRACE("  Flags:\t0x%x\r\n", Ehdr->Flags);
+
+    /**
+     * ELF header size in bytes
+     */
+    TRACE("  Size of this headers:\t%d (bytes)\r\n", Ehdr->Ehsize);
+
+    /**
+     * Program header table entry size
+     */
+    TRACE("  Size of this program headers:\t%d (bytes)\r\n", Ehdr->Phentsize);
+
+    /**
+     * Program header table entry count
+     */
+    TRACE("  Number of program headers:\t%u\r\n", Ehdr->Phnum);
+
+    /**
+     * Section header table entry size
+     */
+    TRACE("  Size of section headers:\t%d (bytes)\r\n", Ehdr->Shentsize);
+
+    /**
+     * Section header table entry count
+     */
+    TRACE("  Number of section headers:\t%u\r\n", Ehdr->Shnum);
+
+    /**
+     * Section header string table index
+     */
+    TRACE("  Section header string table index:\t%u\r\n", Ehdr->Shstrndx);
+
+    return 0;
+}
+
+static NK_Int
+Elf_section(NK_This) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    NKLOG(NK_Log, NKL_Alert, "ELF section begin");
+
+    NK_UInt32 i;
+    const NK_ElfHeader *Header = &Privated->Header;
+    NK_ElfSection *Sections = NK_Nil;
+    NK_UInt64 Major = 0, Minor = 0;
+    NK_GetFaults(&Major, &Minor);
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Sections, -1);
+
+    TRACE("There are %u section headers, starting at offset 0x%llx\n\n", Header->Shnum, (unsigned long long)Header->Shoff);
+    TRACE("Section Headers:\n");
+    TRACE("  [Nr] Name              Type            Addr     Off      Size     ES       Flg Lk       Inf      Al       \n");
+
+    for (i = 0; i < Header->Shnum; i++) {
+
+        NK_Char Flags[16];
+        Elf_section_flags(Sections[i].Flags, Flags);
+
+        TRACE("  [%2u] %-17s %-15s %08llx %08llx %08llx %08llx %-3s %08x %08x %08llx\n"
+            , i, Elf_section_name(Privated, &Sections[i]), Elf_section_type(Sections[i].Type)
+            , (unsigned long long)Sections[i].Addr, (unsigned long long)Sections[i].Offset
+            , (unsigned long long)Sections[i].Size, (unsigned long long)Sections[i].Entsize
+            , Flags, Sections[i].Link, Sections[i].Info, (unsigned long long)Sections[i].Addralign);
+    }
+
+    TRACE("Key to Flags:\n");
+    TRACE("  W (write), A (alloc), X (execute), M (merge), S (strings), I (info),\n");
+    TRACE("  L (link order), O (extra OS processing required), G (group), T (TLS), C (compressed)\n");
+
+    Elf_account(Privated, Major, Minor);
+
+    return 0;
+}
+
+/**
+ * 排序键比较，键相同时按段索引。
+ */
+static NK_Int
+Elf_cmp_key(const NK_Void *a, const NK_Void *b) {
 
-    /// elf 源路径
-    NK_Char Path[256];
+    const NK_ElfKey *A = a, *B = b;
 
-    /// elf 源
-    NK_PVoid Src;
+    if (A->Key != B->Key)
+        return A->Key < B->Key ? -1 : 1;
+    return A->Index < B->Index ? -1 : (A->Index > B->Index ? 1 : 0);
+}
 
-} NK_PrivatedParser;
+/**
+ * 按键对 @ref Keys 做低位优先的基数排序，结果与 @ref Elf_cmp_key() 的顺序一致（排序稳定）。\n
+ * 一次扫描统计全部 8 个字节的分布，所有键在某字节上相同时跳过该趟，\n
+ * 地址通常只有低几个字节不同，大量键只需两三趟线性扫描。@ref Swap 与 @ref Keys 等长，失败返回 NK_Nil。
+ */
+static NK_ElfKey *
+Elf_radix_keys(NK_ElfKey *Keys, NK_ElfKey *Swap, NK_Size Cnt) {
+
+    NK_Size (*Counts)[256] = NK_Nil;
+    NK_ElfKey *Tmp = NK_Nil;
+    NK_Size i, Byte;
+
+    Counts = calloc(8, sizeof(*Counts));
+    NK_EXPECT_RETURN_VAL(NK_Nil != Counts, NK_Nil);
+
+    for (i = 0; i < Cnt; i++) {
+        for (Byte = 0; Byte < 8; Byte++)
+            Counts[Byte][(Keys[i].Key >> (Byte * 8)) & 0xff]++;
+    }
+
+    for (Byte = 0; Byte < 8; Byte++) {
+
+        NK_Size Sum = 0, Bucket;
+
+        if (Cnt == Counts[Byte][Keys[0].Key >> (Byte * 8) & 0xff]) {
+            continue;
+        }
+
+        for (Bucket = 0; Bucket < 256; Bucket++) {
+            NK_Size N = Counts[Byte][Bucket];
+            Counts[Byte][Bucket] = Sum;
+            Sum += N;
+        }
+
+        for (i = 0; i < Cnt; i++)
+            Swap[Counts[Byte][(Keys[i].Key >> (Byte * 8)) & 0xff]++] = Keys[i];
+
+        Tmp = Keys, Keys = Swap, Swap = Tmp;
+    }
+
+    free(Counts);
+
+    return Keys;
+}
+
+static NK_Int
+Elf_cmp_index(const NK_Void *a, const NK_Void *b) {
+
+    NK_UInt32 A = *(const NK_UInt32 *)a, B = *(const NK_UInt32 *)b;
+    return A < B ? -1 : (A > B ? 1 : 0);
+}
 
 /**
- * 通过模块公有句柄获取私有句柄。
+ * 有序键中第一个不小于 @ref Key 的位置。
  */
-static inline NK_PrivatedParser *
-PRIVATED(NK_Parser *Public) {
+static NK_UInt32
+Elf_lower_key(const NK_ElfKey *Keys, NK_UInt32 Cnt, NK_UInt64 Key) {
 
-    /// 偏移到私有句柄。
-    return (NK_PrivatedParser *)Public - 1;
+    NK_UInt32 Low = 0, High = Cnt;
+
+    while (Low < High) {
+        NK_UInt32 Mid = Low + (High - Low) / 2;
+        if (Keys[Mid].Key < Key)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+
+    return Low;
 }
 
 /**
- * 定义私有句柄。
+ * 段是否属于程序段，规则与 binutils 的 ELF_SECTION_IN_SEGMENT_STRICT 一致：\n
+ * 有文件内容的段须完整落在程序段的文件范围内，占内存的段须完整落在程序段的地址范围内。
  */
-#define DECLARE_PRIVATED() NK_PrivatedParser *Privated = PRIVATED(Public)
+static NK_Boolean
+Elf_section_in_segment(const NK_ElfSection *Section, const NK_ElfPhdr *Phdr) {
+
+    NK_Boolean Tls = 0 != (Section->Flags & SHF_TLS);
+    NK_Boolean Alloc = 0 != (Section->Flags & SHF_ALLOC);
+
+    /// TLS 段只属于 TLS、LOAD 与 GNU_RELRO 程序段，.tbss 只属于 TLS 程序段。
+    if (Tls) {
+        if (PT_TLS != Phdr->Type && PT_LOAD != Phdr->Type && PT_GNU_RELRO != Phdr->Type)
+            return NK_False;
+        if (SHT_NOBITS == Section->Type && PT_TLS != Phdr->Type)
+            return NK_False;
+    } else if (PT_TLS == Phdr->Type || PT_PHDR == Phdr->Type) {
+        return NK_False;
+    }
+
+    /// 不占内存的段不属于描述内存映像的程序段。
+    if (!Alloc && (PT_LOAD == Phdr->Type || PT_DYNAMIC == Phdr->Type || PT_GNU_EH_FRAME == Phdr->Type
+        || PT_GNU_STACK == Phdr->Type || PT_GNU_RELRO == Phdr->Type)) {
+        return NK_False;
+    }
+
+    if (SHT_NOBITS != Section->Type
+        && !(Section->Offset >= Phdr->Offset && Section->Offset - Phdr->Offset <= Phdr->Filesz - 1
+            && Section->Offset - Phdr->Offset + Section->Size <= Phdr->Filesz)) {
+        return NK_False;
+    }
+
+    if (Alloc
+        && !(Section->Addr >= Phdr->Vaddr && Section->Addr - Phdr->Vaddr <= Phdr->Memsz - 1
+            && Section->Addr - Phdr->Vaddr + Section->Size <= Phdr->Memsz)) {
+        return NK_False;
+    }
+
+    /// 空的段不计入 DYNAMIC 程序段的边界处。
+    if (PT_DYNAMIC == Phdr->Type && 0 == Section->Size && 0 != Phdr->Memsz
+        && !((SHT_NOBITS == Section->Type
+                || (Section->Offset > Phdr->Offset && Section->Offset - Phdr->Offset < Phdr->Filesz))
+            && (!Alloc || (Section->Addr > Phdr->Vaddr && Section->Addr - Phdr->Vaddr < Phdr->Memsz)))) {
+        return NK_False;
+    }
+
+    return NK_True;
+}
 
 /**
- * NK_This 指针定义，\n
- * 定义以下为模块 API 接口实现。
+ * 找出属于程序段 @ref Phdr 的段，写入 @ref Match，返回段数。\n
+ * 候选只来自有序键中落在程序段范围内的一段：有文件内容的段按文件偏移（@ref Files），\n
+ * 占内存而无文件内容的段按地址（@ref Addrs），每个程序段只需一次二分查找加区间内扫描。
  */
-#define NK_This NK_Parser * const Public
+static NK_UInt32
+Elf_map_segment(const NK_ElfSection *Sections, const NK_ElfPhdr *Phdr
+    , const NK_ElfKey *Files, NK_UInt32 FileCnt, const NK_ElfKey *Addrs, NK_UInt32 AddrCnt, NK_UInt32 *Match) {
 
-#define NK_Log ("Parser")
+    NK_UInt32 Cnt = 0;
+    NK_UInt32 i;
+
+    for (i = Elf_lower_key(Files, FileCnt, Phdr->Offset); i < FileCnt && Files[i].Key - Phdr->Offset <= Phdr->Filesz; i++) {
+        if (Elf_section_in_segment(&Sections[Files[i].Index], Phdr))
+            Match[Cnt++] = Files[i].Index;
+    }
+
+    for (i = Elf_lower_key(Addrs, AddrCnt, Phdr->Vaddr); i < AddrCnt && Addrs[i].Key - Phdr->Vaddr <= Phdr->Memsz; i++) {
+        if (Elf_section_in_segment(&Sections[Addrs[i].Index], Phdr))
+            Match[Cnt++] = Addrs[i].Index;
+    }
+
+    /// 按段索引输出。
+    qsort(Match, Cnt, sizeof(NK_UInt32), Elf_cmp_index);
+
+    return Cnt;
+}
 
 /**
- * parse start。
+ * dump program headers。
  */
 static NK_Int
-Elf_parse(NK_This) {
+Elf_segments(NK_This) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    NKLOG(NK_Log, NKL_Alert, "ELF segments begin");
+
+    NK_UInt32 i, k;
+    const NK_ElfHeader *Header = &Privated->Header;
+    const NK_ElfClass *Class = Privated->Class;
+    NK_ElfSection *Sections = NK_Nil;
+    NK_PVoid Table = NK_Nil;
+    NK_ElfPhdr *Phdrs = NK_Nil;
+    NK_ElfKey *Keys = NK_Nil;
+    NK_UInt32 *Match = NK_Nil;
+    NK_UInt32 Files = 0, Addrs = 0;
+    NK_Int Ret = -1;
+    NK_UInt64 Major = 0, Minor = 0;
+    NK_GetFaults(&Major, &Minor);
+
+    if (0 == Header->Phnum) {
+        TRACE("There are no program headers in this file.\n");
+        Elf_account(Privated, Major, Minor);
+        return 0;
+    }
+
+    NK_EXPECT_VERBOSE_RETURN_VAL(Class->Phentsize == Header->Phentsize, -1);
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Sections, -1);
+
+    /// 程序头表只读取一次。
+    Elf_advise(Privated, Header->Phoff, (NK_Size64)Header->Phnum * Class->Phentsize, NK_ADVICE_WILLNEED);
+    Table = Elf_native(Privated, Header->Phoff, (NK_Size64)Header->Phnum * Class->Phentsize, Class->Phentsize, &Class->PhdrLayout);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Table, -1);
+
+    Phdrs = calloc(Header->Phnum, sizeof(NK_ElfPhdr));
+    Keys = calloc((NK_Size)Header->Shnum + 1, sizeof(NK_ElfKey));
+    Match = calloc((NK_Size)Header->Shnum + 1, sizeof(NK_UInt32));
+    NK_EXPECT_VERBOSE_JUMP(NK_Nil != Phdrs && NK_Nil != Keys && NK_Nil != Match, _exit);
+
+    TRACE("There are %u program headers, starting at offset 0x%llx\n\n", Header->Phnum, (unsigned long long)Header->Phoff);
+    TRACE("Program Headers:\n");
+    TRACE("  [Nr] Type           Offset   VirtAddr         PhysAddr         FileSiz  MemSiz   Flg Align\n");
+
+    for (i = 0; i < Header->Phnum; i++) {
+
+        NK_Char Flags[4];
+        Class->phdr(Table, i, &Phdrs[i]);
+        Elf_segment_flags(Phdrs[i].Flags, Flags);
+
+        TRACE("  [%2u] %-14s %08llx %016llx %016llx %08llx %08llx %-3s %llx\n"
+            , i, Elf_segment_type(Phdrs[i].Type)
+            , (unsigned long long)Phdrs[i].Offset, (unsigned long long)Phdrs[i].Vaddr
+            , (unsigned long long)Phdrs[i].Paddr, (unsigned long long)Phdrs[i].Filesz
+            , (unsigned long long)Phdrs[i].Memsz, Flags, (unsigned long long)Phdrs[i].Align);
+    }
+
+    /// 有文件内容的段按文件偏移排在前部，占内存而无文件内容的段按地址排在后部，0 号段不参与。
+    for (i = 1; i < Header->Shnum; i++) {
+
+        if (SHT_NOBITS != Sections[i].Type) {
+            Keys[Files].Key = Sections[i].Offset;
+            Keys[Files].Index = i;
+            Files++;
+        } else if (Sections[i].Flags & SHF_ALLOC) {
+            Addrs++;
+            Keys[Header->Shnum - Addrs].Key = Sections[i].Addr;
+            Keys[Header->Shnum - Addrs].Index = i;
+        }
+    }
+
+    qsort(Keys, Files, sizeof(NK_ElfKey), Elf_cmp_key);
+    qsort(Keys + Header->Shnum - Addrs, Addrs, sizeof(NK_ElfKey), Elf_cmp_key);
+
+    TRACE("\n Section to Segment mapping:\n");
+    TRACE("  Segment Sections...\n");
+
+    for (i = 0; i < Header->Phnum; i++) {
+
+        NK_UInt32 Cnt = Elf_map_segment(Sections, &Phdrs[i], Keys, Files, Keys + Header->Shnum - Addrs, Addrs, Match);
+
+        TRACE("   %02u     ", i);
+        for (k = 0; k < Cnt; k++) {
+            TRACE("%s ", Elf_section_name(Privated, &Sections[Match[k]]));
+        }
+        TRACE("\n");
+    }
+
+    Ret = 0;
+
+_exit:
+    free(Phdrs);
+    free(Keys);
+    free(Match);
+
+    Elf_account(Privated, Major, Minor);
+
+    return Ret;
+}
+
+static NK_Int
+Elf_symtab(NK_This) {
 
     /// 检测句柄异常。
     NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
@@ -83,352 +3310,429 @@ Elf_parse(NK_This) {
     /// 获取私有句柄。
     DECLARE_PRIVATED();
 
-    NK_EXPECT_VERBOSE_RETURN_VAL(0 < NK_ReadFile2Buffer(Privated->Path, (NK_PChar *)(&Privated->Src)), -1);
-    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Src, -1);
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    NKLOG(NK_Log, NKL_Alert, "ELF symtab begin");
+
+    NK_UInt32 i;
+    NK_Size64 k;
+    NK_ElfSymbol Symbol;
+    NK_ElfSection *Sections = NK_Nil;
+    NK_UInt64 Major = 0, Minor = 0;
+    NK_GetFaults(&Major, &Minor);
+
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Sections, -1);
+
+    for (i = 0; i < Privated->Header.Shnum; i++) {
+
+        const NK_ElfSection *Section = &Sections[i];
+
+        /// 不是符号表
+        if (SHT_SYMTAB != Section->Type && SHT_DYNSYM != Section->Type) {
+            continue;
+        }
+
+        const NK_ElfSymtab *Symtab = Elf_open_symtab(Privated, Sections, i);
+        NK_EXPECT_VERBOSE_CONTINUE(NK_Nil != Symtab);
+
+        TRACE("Symbol table '%s' contains %llu entries:\n", Elf_section_name(Privated, Section), (unsigned long long)Symtab->Cnt);
+        TRACE("  [  Nr] Value    Size     Type     Bind     Vis       Ndx  Name\n");
+
+        for (k = 0; k < Symtab->Cnt; k++) {
+            Privated->Class->symbol(Symtab, k, &Symbol);
+            Elf_print_symbol(&Symbol);
+        }
+
+        /// 符号表顺序访问，输出完毕后释放其页面。
+        Elf_advise(Privated, Section->Offset, Section->Size, NK_ADVICE_DONTNEED);
+    }
+
+    Elf_account(Privated, Major, Minor);
 
     return 0;
 }
 
 /**
- * dump header。
+ * 获取段内容视图。
  */
 static NK_Int
-Elf_header(NK_This) {
+Elf_span(NK_This, NK_Int index, NK_ElfSpan *span) {
 
     /// 检测句柄异常。
     NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != span, -1);
 
     /// 获取私有句柄。
     DECLARE_PRIVATED();
 
     /// 数据源检查
-    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Src, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-    NKLOG(NK_Log, NKL_Alert, "ELF header begin");
+    NK_ElfSection *Sections = NK_Nil;
 
-    NK_Int i;
-    Elf32_Ehdr *Ehdr = (Elf32_Ehdr *)(Privated->Src);
+    NK_EXPECT_VERBOSE_RETURN_VAL(index >= 0 && (NK_UInt32)index < Privated->Header.Shnum, -1);
+    Sections = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Sections, -1);
 
-    TRACE("ELF Headers:\n");
+    /// NOBITS 段在文件中没有内容。
+    if (SHT_NOBITS == Sections[index].Type) {
+        span->Data = NK_Nil;
+        span->Size = 0;
+        return 0;
+    }
 
-    /**
-     * Magic number and other info
-     */
-    for (i = 0; i < EI_NIDENT; i++) {
+    /// 直接指向映射或加载的内容，越界时失败。
+    span->Data = Elf_fetch(Privated, Sections[index].Offset, Sections[index].Size);
+    NK_EXPECT_RETURN_VAL(NK_Nil != span->Data, -1);
+    span->Size = Sections[index].Size;
 
-        if (0 == i)
-            TRACE("  Magic:\t%02hhx ", Ehdr->e_ident[i]);
-        else if ((i + 1) == EI_NIDENT)
-            TRACE("%02hhx\r\n", Ehdr->e_ident[i]);
-        else
-            TRACE("%02hhx ", Ehdr->e_ident[i]);
-    }
+    return 0;
+}
+
+/**
+ * 按段名获取段内容视图。
+ */
+static NK_Int
+Elf_span_by_name(NK_This, const NK_PChar name, NK_ElfSpan *span) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != name, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    NK_Int Index = Elf_lookup_section(Privated, name);
 
-    if (memcmp(&Ehdr->e_ident[EI_MAG0], ELFMAG, SELFMAG)) {
+    if (Index < 0) {
         return -1;
     }
 
-    switch (Ehdr->e_ident[EI_CLASS])
-    {
-    case ELFCLASS32:
-        TRACE("  Class:\tELF32\r\n"); break;
-    case ELFCLASS64:
-        TRACE("  Class:\tELF64\r\n"); break;
-    default:
-        TRACE("  Class:\tInvalid class\r\n"); break;
-    }
+    return Elf_span(Public, Index, span);
+}
 
-    switch (Ehdr->e_ident[EI_DATA])
-    {
-    case ELFDATA2LSB:
-        TRACE("  Date:t\t1's complement, little endian\r\n"); break;
-    case ELFDATA2MSB:
-        TRACE("  Date:t\t2's complement, big endian\r\n"); break;
-    default:
-        TRACE("  Date:\t\tInvalid data encoding\r\n"); break;
-    }
+/**
+ * 按段名查找段索引。
+ */
+static NK_Int
+Elf_find_section(NK_This, const NK_PChar name) {
 
-    TRACE("  Version:\t%d\r\n", Ehdr->e_ident[EI_VERSION]);
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != name, -1);
 
-    switch (Ehdr->e_ident[EI_OSABI])
-    {
-    case ELFOSABI_NONE:
-        TRACE("  OS/ABI:\tUNIX System V ABI\r\n"); break;
-    default:
-        TRACE("  OS/ABI:\tUnknow\r\n"); break;
-    }
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
 
-    TRACE("  ABI Version:\t%d\r\n", Ehdr->e_ident[EI_ABIVERSION]);
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-    /**
-     * Object file type
-     */
-    switch (Ehdr->e_type)
-    {
-    case ET_REL:
-        TRACE("  Type:\t\tREL (Relocatable file)\r\n"); break;
-    case ET_EXEC:
-        TRACE("  Type:\t\tEXEC (Executable file)\r\n"); break;
-    case ET_DYN:
-        TRACE("  Type:\t\tDYN (Shared object file)\r\n"); break;
-    case ET_CORE:
-        TRACE("  Type:\t\tCORE (Core file)\r\n"); break;
-    default:
-        TRACE("  Type:\t\tNONE (No file type)\r\n"); break;
+    return Elf_lookup_section(Privated, name);
+}
+
+/**
+ * 开始遍历段表。
+ */
+static NK_Int
+Elf_sections_begin(NK_This, NK_ElfCursor *cursor) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != cursor, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
+
+    cursor->Opaque = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != cursor->Opaque, -1);
+
+    cursor->Table = -1;
+    cursor->Next = 0;
+    cursor->Count = Privated->Header.Shnum;
+
+    return 0;
+}
+
+/**
+ * 读取下一个段描述，直接由段描述表复制。
+ */
+static NK_Int
+Elf_next_section(NK_This, NK_ElfCursor *cursor, NK_ElfSectionInfo *section) {
+
+    const NK_ElfSection *Section = NK_Nil;
+
+    NK_EXPECT_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != cursor && NK_Nil != section, -1);
+    NK_EXPECT_RETURN_VAL(-1 == cursor->Table && NK_Nil != cursor->Opaque, -1);
+
+    if (cursor->Next >= cursor->Count) {
+        return -1;
     }
 
-    /**
-     * Architecture
-     */
-    TRACE("  Machine:\t%d\r\n", Ehdr->e_machine);
+    Section = (const NK_ElfSection *)cursor->Opaque + cursor->Next;
+
+    section->Index      = (NK_Int)cursor->Next;
+    section->Name       = Elf_section_name(PRIVATED(Public), Section);
+    section->Type       = Section->Type;
+    section->Flags      = Section->Flags;
+    section->Addr       = Section->Addr;
+    section->Offset     = Section->Offset;
+    section->Size       = Section->Size;
+    section->Link       = Section->Link;
+    section->Info       = Section->Info;
+    section->Addralign  = Section->Addralign;
+    section->Entsize    = Section->Entsize;
+
+    cursor->Next++;
+
+    return 0;
+}
+
+/**
+ * 开始遍历符号表。
+ */
+static NK_Int
+Elf_symbols_begin(NK_This, NK_Int index, NK_ElfCursor *cursor) {
 
-    /**
-     * Object file version
-     */
-    TRACE("  Version:\t%d\r\n", Ehdr->e_version);
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != cursor, -1);
 
-    /**
-     * Entry point virtual address
-     */
-    TRACE("  Entry Point address:\t0x%x\r\n", Ehdr->e_entry);
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
 
-    /**
-     * Program header table file offset
-     */
-    TRACE("  Start of program headers\t%d (bytes into file)\r\n", Ehdr->e_phoff);
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-    /**
-     * Section header table file offset
-     */
-    TRACE("  Start of section headers:\t%d (bytes into file)\r\n", Ehdr->e_shoff);
+    NK_ElfSection *Sections = Elf_sections(Privated);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Sections, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(index >= 0 && (NK_UInt32)index < Privated->Header.Shnum, -1);
 
-    /**
-     * Processor-specific flags
-     */
-    TRACE("  Flags:\t0x%x\r\n", Ehdr->e_flags);
+    const NK_ElfSymtab *Symtab = Elf_open_symtab(Privated, Sections, index);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Symtab, -1);
 
-    /**
-     * ELF header size in bytes
-     */
-    TRACE("  Size of this headers:\t%d (bytes)\r\n", Ehdr->e_ehsize);
+    cursor->Table = index;
+    cursor->Next = 0;
+    cursor->Count = Symtab->Cnt;
+    cursor->Opaque = Symtab;
 
-    /**
-     * Program header table entry size
-     */
-    TRACE("  Size of this program headers:\t%d (bytes)\r\n", Ehdr->e_phentsize);
+    return 0;
+}
 
-    /**
-     * Program header table entry count
-     */
-    TRACE("  Number of program headers:\t%d\r\n", Ehdr->e_phnum);
+/**
+ * 读取下一个符号，由本类别的实现解码。
+ */
+static NK_Int
+Elf_next_symbol(NK_This, NK_ElfCursor *cursor, NK_ElfSymbol *symbol) {
 
-    /**
-     * Section header table entry size
-     */
-    TRACE("  Size of section headers:\t%d (bytes)\r\n", Ehdr->e_shentsize);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != cursor && NK_Nil != symbol, -1);
+    NK_EXPECT_RETURN_VAL(cursor->Table >= 0 && NK_Nil != cursor->Opaque, -1);
 
-    /**
-     * Section header table entry count
-     */
-    TRACE("  Number of section headers:\t%d\r\n", Ehdr->e_shnum);
+    if (cursor->Next >= cursor->Count) {
+        return -1;
+    }
 
-    /**
-     * Section header string table index
-     */
-    TRACE("  Section header string table index:\t%d\r\n", Ehdr->e_shstrndx);
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    Privated->Class->symbol(cursor->Opaque, cursor->Next++, symbol);
 
     return 0;
 }
 
+/**
+ * 按名查找符号。
+ */
 static NK_Int
-Elf_section(NK_This) {
+Elf_lookup_symbol(NK_This, const NK_PChar name, NK_ElfSymbol *symbol) {
 
     /// 检测句柄异常。
     NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != name && NK_Nil != symbol, -1);
 
     /// 获取私有句柄。
     DECLARE_PRIVATED();
 
     /// 数据源检查
-    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Src, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-    NKLOG(NK_Log, NKL_Alert, "ELF section begin");
+    return Elf_lookup(Privated, name, symbol);
+}
 
-    NK_Int i;
-    Elf32_Ehdr *Ehdr = (Elf32_Ehdr *)(Privated->Src);
-    Elf32_Shdr *Shdr = (Elf32_Shdr *)(Privated->Src + Ehdr->e_shoff);
+/**
+ * 按地址查找符号。
+ */
+static NK_Int
+Elf_symbol_at(NK_This, NK_UInt64 address, NK_ElfSymbol *symbol) {
 
-    TRACE("There are %d section headers, starting at offset 0x%x\n\n", Ehdr->e_shnum, Ehdr->e_shoff);
-    TRACE("Section Headers:\n");
-    TRACE("  [Nr] Name              Type            Addr     Off      Size     ES       Flg Lk       Inf      Al       \n");
+    const NK_ElfAddresses *Addresses = NK_Nil;
+    const NK_ElfExtent *Extent = NK_Nil;
 
-    for (i = 0; i < Ehdr->e_shnum; i++) {
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != symbol, -1);
 
-        /// 从"段表字符串表"找出段名
-        NK_Char *Name = (NK_Char *)(Privated->Src + Shdr[Ehdr->e_shstrndx].sh_offset + Shdr[i].sh_name);
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
 
-        NK_Char Type[16] = {""};
-        switch (Shdr[i].sh_type)
-        {
-        case SHT_NULL:
-            snprintf(Type, sizeof(Type), "NULL"); break;
-        case SHT_PROGBITS:
-            snprintf(Type, sizeof(Type), "PROGBITS"); break;
-        case SHT_SYMTAB:
-            snprintf(Type, sizeof(Type), "SYMTAB"); break;
-        case SHT_STRTAB:
-            snprintf(Type, sizeof(Type), "STRTAB"); break;
-        case SHT_RELA:
-            snprintf(Type, sizeof(Type), "RELA"); break;
-        case SHT_HASH:
-            snprintf(Type, sizeof(Type), "HASH"); break;
-        case SHT_DYNAMIC:
-            snprintf(Type, sizeof(Type), "DYNAMIC"); break;
-        case SHT_NOTE:
-            snprintf(Type, sizeof(Type), "NOTE"); break;
-        case SHT_NOBITS:
-            snprintf(Type, sizeof(Type), "NOBITS"); break;
-        case SHT_REL:
-            snprintf(Type, sizeof(Type), "REL"); break;
-        case SHT_SHLIB:
-            snprintf(Type, sizeof(Type), "SHLIB"); break;
-        case SHT_DYNSYM:
-            snprintf(Type, sizeof(Type), "DYNSYM"); break;
-        case SHT_INIT_ARRAY:
-            snprintf(Type, sizeof(Type), "INIT_ARRAY"); break;
-        case SHT_FINI_ARRAY:
-            snprintf(Type, sizeof(Type), "FINI_ARRAY"); break;
-        case SHT_PREINIT_ARRAY:
-            snprintf(Type, sizeof(Type), "PREINIT_ARRAY"); break;
-        case SHT_GROUP:
-            snprintf(Type, sizeof(Type), "GROUP"); break;
-        case SHT_SYMTAB_SHNDX:
-            snprintf(Type, sizeof(Type), "SYMTAB_SHNDX"); break;
-        default:
-            break;
-        }
+    /// 数据源检查
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-        NK_Char Flags[16] = {""};
-        if (Shdr[i].sh_flags & SHF_WRITE)               strcat(Flags, "W");
-        if (Shdr[i].sh_flags & SHF_ALLOC)               strcat(Flags, "A");
-        if (Shdr[i].sh_flags & SHF_EXECINSTR)           strcat(Flags, "X");
-        if (Shdr[i].sh_flags & SHF_MERGE)               strcat(Flags, "M");
-        if (Shdr[i].sh_flags & SHF_STRINGS)             strcat(Flags, "S");
-        if (Shdr[i].sh_flags & SHF_INFO_LINK)           strcat(Flags, "I");
-        if (Shdr[i].sh_flags & SHF_LINK_ORDER)          strcat(Flags, "L");
-        if (Shdr[i].sh_flags & SHF_OS_NONCONFORMING)    strcat(Flags, "O");
-        if (Shdr[i].sh_flags & SHF_GROUP)               strcat(Flags, "G");
-        if (Shdr[i].sh_flags & SHF_TLS)                 strcat(Flags, "T");
-        if (Shdr[i].sh_flags & SHF_COMPRESSED)          strcat(Flags, "C");
+    Addresses = Elf_addresses(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Addresses, -1);
 
-        TRACE("  [%2d] %-17s %-15s %08x %08x %08x %08x %-3s %08x %08x %08x\n"
-            , i, Name, Type, Shdr[i].sh_addr, Shdr[i].sh_offset, Shdr[i].sh_size, Shdr[i].sh_entsize
-            , Flags, Shdr[i].sh_link, Shdr[i].sh_info, Shdr[i].sh_addralign);
+    Extent = Elf_locate(Addresses, address);
+    if (NK_Nil == Extent) {
+        return -1;
     }
 
-    TRACE("Key to Flags:\n");
-    TRACE("  W (write), A (alloc), X (execute), M (merge), S (strings), I (info),\n");
-    TRACE("  L (link order), O (extra OS processing required), G (group), T (TLS), C (compressed)\n");
+    Privated->Class->symbol(Addresses->Symtab, Extent->Index, symbol);
 
     return 0;
 }
 
+/**
+ * 地址索引不超过此项数时（起始地址约 256KB），Eytzinger 布局可常驻 L2 缓存，\n
+ * 无序地址逐个查找比先排序再归并更快。
+ */
+#define NK_ELF_RESIDENT_EXTENTS (32768)
+
+/**
+ * 填写 @ref Addr 落在 @ref Extent 内的结果，@ref Symbol 缓存上一次解码的符号，索引相同时不再解码。
+ */
+static inline NK_Void
+Elf_place(NK_PrivatedParser *Privated, const NK_ElfAddresses *Addresses, const NK_ElfExtent *Extent
+    , NK_UInt64 Addr, NK_ElfSymbol *Symbol, NK_ElfLocation *Location) {
+
+    if (Symbol->Index != Extent->Index) {
+        Privated->Class->symbol(Addresses->Symtab, Extent->Index, Symbol);
+    }
+
+    Location->Index = (NK_Int64)Extent->Index;
+    Location->Offset = Addr - Extent->Addr;
+    Location->Name = Symbol->Name;
+}
+
+/**
+ * 批量按地址查找符号。\n
+ * 地址按升序与索引项做一次归并：索引项的游标只前进不后退，总代价与 地址数 + 符号数 成正比；\n
+ * 地址无序时先对 (地址, 输入位置) 做基数排序（见 @ref Elf_radix_keys()），结果仍按输入位置写回。\n
+ * 地址远少于符号，或地址无序而索引可常驻缓存（见 @ref NK_ELF_RESIDENT_EXTENTS）时，\n
+ * 逐个用 @ref Elf_locate() 查找更省，不排序也不申请内存。
+ */
 static NK_Int
-Elf_symtab(NK_This) {
+Elf_symbolize(NK_This, const NK_UInt64 *addresses, NK_Size count, NK_ElfLocation *locations) {
+
+    const NK_ElfAddresses *Addresses = NK_Nil;
+    const NK_ElfExtent *Extent = NK_Nil;
+    NK_ElfKey *Keys = NK_Nil;
+    NK_ElfKey *Order = NK_Nil;
+    NK_ElfSymbol Symbol;
+    NK_Boolean Sorted = NK_True;
+    NK_UInt64 Next = 0;
+    NK_Size i;
 
     /// 检测句柄异常。
     NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(0 == count || (NK_Nil != addresses && NK_Nil != locations), -1);
 
     /// 获取私有句柄。
     DECLARE_PRIVATED();
 
     /// 数据源检查
-    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Src, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Privated->Class, -1);
 
-    NKLOG(NK_Log, NKL_Alert, "ELF symtab begin");
-
-    NK_Int i;
-    NK_Int ii;
-    Elf32_Ehdr *Ehdr = (Elf32_Ehdr *)(Privated->Src);
-    Elf32_Shdr *Shdr = (Elf32_Shdr *)(Privated->Src + Ehdr->e_shoff);
+    Addresses = Elf_addresses(Privated);
+    NK_EXPECT_RETURN_VAL(NK_Nil != Addresses, -1);
 
-    for (i = 0; i < Ehdr->e_shnum; i++) {
+    for (i = 0; i < count; i++) {
+        locations[i].Index = -1;
+        locations[i].Offset = 0;
+        locations[i].Name = "";
+    }
 
-        /// 不是符号表
-        if (SHT_SYMTAB != Shdr[i].sh_type && SHT_DYNSYM != Shdr[i].sh_type) {
-            continue;
-        }
+    if (NK_Nil == Addresses->Symtab) {
+        return -1;
+    }
 
-        /// 从"段表字符串表"找出段名
-        NK_Char *Name = (NK_Char *)(Privated->Src + Shdr[Ehdr->e_shstrndx].sh_offset + Shdr[i].sh_name);
+    /// 尚未解码任何符号。
+    Symbol.Index = (NK_Size64)-1;
 
-        /// 获取符号数
-        NK_Int Cnt = Shdr[i].sh_size / Shdr[i].sh_entsize;
+    for (i = 1; i < count && addresses[i - 1] <= addresses[i]; i++)
+        ;
+    Sorted = i >= count ? NK_True : NK_False;
 
-        TRACE("Symbol table '%s' contains %d entries:\n", Name, Cnt);
-        TRACE("  [  Nr] Value    Size     Type     Bind     Vis       Ndx  Name\n");
+    if ((NK_UInt64)count * 8 < Addresses->Cnt || (!Sorted && Addresses->Cnt <= NK_ELF_RESIDENT_EXTENTS)) {
+        for (i = 0; i < count; i++) {
+            Extent = Elf_locate(Addresses, addresses[i]);
+            if (NK_Nil != Extent)
+                Elf_place(Privated, Addresses, Extent, addresses[i], &Symbol, &locations[i]);
+        }
+        return Addresses->Table;
+    }
 
-        /// 获取符号表
-        Elf32_Sym *Sym = (Elf32_Sym *)(Privated->Src + Shdr[i].sh_offset);
-
-        for (ii = 0; ii < Cnt; ii++) {
-
-            NK_Char Type[16] = {""};
-            switch (ELF32_ST_TYPE(Sym[ii].st_info))
-            {
-            case STT_NOTYPE:
-                snprintf(Type, sizeof(Type), "NOTYPE"); break;
-            case STT_OBJECT:
-                snprintf(Type, sizeof(Type), "OBJECT"); break;
-            case STT_FUNC:
-                snprintf(Type, sizeof(Type), "FUNC"); break;
-            case STT_SECTION:
-                snprintf(Type, sizeof(Type), "SECTION"); break;
-            case STT_FILE:
-                snprintf(Type, sizeof(Type), "FILE"); break;
-            case STT_COMMON:
-                snprintf(Type, sizeof(Type), "COMMON"); break;
-            case STT_TLS:
-                snprintf(Type, sizeof(Type), "TLS"); break;
-            default:
-                break;
-            }
+    if (!Sorted) {
+        /// 两份键数组，calloc 检查长度溢出；输入位置与 count 同为 NK_Size，存入 Index 不会截断。
+        Keys = calloc(count, sizeof(NK_ElfKey) * 2);
+        NK_EXPECT_RETURN_VAL(NK_Nil != Keys, -1);
+        for (i = 0; i < count; i++) {
+            Keys[i].Key = addresses[i];
+            Keys[i].Index = i;
+        }
+        Order = Elf_radix_keys(Keys, Keys + count, count);
+        NK_EXPECT_JUMP(NK_Nil != Order, _fail_exit);
+    }
 
-            NK_Char Bind[16] = {""};
-            switch (ELF32_ST_BIND(Sym[ii].st_info))
-            {
-            case STB_LOCAL:
-                snprintf(Bind, sizeof(Bind), "LOCAL"); break;
-            case STB_GLOBAL:
-                snprintf(Bind, sizeof(Bind), "GLOBAL"); break;
-            case STB_WEAK:
-                snprintf(Bind, sizeof(Bind), "WEAK"); break;
-            default:
-                break;
-            }
+    for (i = 0; i < count; i++) {
 
-            NK_Char Vis[16] = {""};
-            switch (ELF32_ST_BIND(Sym[ii].st_other))
-            {
-            case STV_DEFAULT:
-                snprintf(Vis, sizeof(Vis), "DEFAULT"); break;
-            case STV_INTERNAL:
-                snprintf(Vis, sizeof(Vis), "INTERNAL"); break;
-            case STV_HIDDEN:
-                snprintf(Vis, sizeof(Vis), "HIDDEN"); break;
-            case STV_PROTECTED:
-                snprintf(Vis, sizeof(Vis), "PROTECTED"); break;
-            default:
-                break;
-            }
+        NK_Size At = Order ? Order[i].Index : i;
+        NK_UInt64 Addr = Order ? Order[i].Key : addresses[i];
 
-            /// 从"段表字符串表"找出段名
-            NK_Char *Name = (NK_Char *)(Privated->Src + Shdr[Ehdr->e_shstrndx].sh_offset + Shdr[i].sh_name);
+        /// 游标停在起始地址不大于 Addr 的最后一项之后。
+        while (Next < Addresses->Cnt && Addresses->Extents[Next].Addr <= Addr)
+            Next++;
 
-            TRACE("  [%4d] %08x %-8d %-8s %-8s %-9s %4d %s\n", ii, Sym[ii].st_value, Sym[ii].st_size, Type, Bind, Vis, Sym[ii].st_shndx, Name);
+        Extent = Elf_enclosing(Addresses, Next, Addr);
+        if (NK_Nil != Extent) {
+            Elf_place(Privated, Addresses, Extent, Addr, &Symbol, &locations[At]);
         }
     }
 
+    free(Keys);
+
+    return Addresses->Table;
+
+_fail_exit:
+    free(Keys);
+    return -1;
+}
+
+/**
+ * 获取访问统计。
+ */
+static NK_Int
+Elf_stats(NK_This, NK_ParseStats *stats) {
+
+    /// 检测句柄异常。
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != stats, -1);
+
+    /// 获取私有句柄。
+    DECLARE_PRIVATED();
+
+    stats->MajorFaults = __atomic_load_n(&Privated->Stats.MajorFaults, __ATOMIC_RELAXED);
+    stats->MinorFaults = __atomic_load_n(&Privated->Stats.MinorFaults, __ATOMIC_RELAXED);
+    stats->Advices = __atomic_load_n(&Privated->Stats.Advices, __ATOMIC_RELAXED);
+
     return 0;
 }
 
@@ -443,17 +3747,99 @@ Elf_symtab(NK_This) {
  */
 #undef NK_This
 
+NK_Int
+NK_Parse_SetCacheDir(const NK_PChar dir) {
+
+    /// 空目录关闭解析缓存。
+    if (NK_Nil == dir) {
+        Elf_CacheDir[0] = '\0';
+        return 0;
+    }
+
+    NK_EXPECT_VERBOSE_RETURN_VAL(strlen(dir) < sizeof(Elf_CacheDir), -1);
+    snprintf(Elf_CacheDir, sizeof(Elf_CacheDir), "%s", dir);
+
+    return 0;
+}
+
 NK_Parser *
 NK_Parse_Create(const NK_PChar elf) {
 
+    return NK_Parse_CreateEx(elf, NK_PARSE_DEFAULT);
+}
+
+/**
+ * 批量读取各句柄的一个区间并挂到句柄上，@ref Ranges 中长度为 0 的跳过。\n
+ * 读取失败的句柄被销毁。
+ */
+static NK_Void
+Elf_batch_fetch(NK_Parser **parsers, NK_ElfRange *Ranges, NK_Int count) {
+
+    NK_ReadRequest *Reqs = NK_Nil;
+    NK_ElfRegion **Regions = NK_Nil;
+    NK_Int Cnt = 0;
+    NK_Int i;
+
+    Reqs = calloc(count, sizeof(NK_ReadRequest));
+    Regions = calloc(count, sizeof(NK_ElfRegion *));
+    NK_EXPECT_JUMP(NK_Nil != Reqs && NK_Nil != Regions, _exit);
+
+    for (i = 0; i < count; i++) {
+
+        if (NK_Nil == parsers[i] || 0 == Ranges[i].Size) {
+            continue;
+        }
+
+        NK_PrivatedParser *Privated = PRIVATED(parsers[i]);
+
+        if (Ranges[i].Offset > Privated->Size || Ranges[i].Size > Privated->Size - Ranges[i].Offset) {
+            continue;
+        }
+
+        Regions[i] = Elf_new_region(Ranges[i].Offset, Ranges[i].Size);
+        NK_EXPECT_CONTINUE(NK_Nil != Regions[i]);
+
+        Reqs[Cnt].Fd = Privated->Fd;
+        Reqs[Cnt].Offset = Ranges[i].Offset;
+        Reqs[Cnt].Size = Ranges[i].Size;
+        Reqs[Cnt].Data = Regions[i]->Data;
+        Cnt++;
+    }
+
+    NK_ReadFileBatch(Reqs, Cnt);
+
+    /// 请求按句柄顺序排列。
+    for (i = 0, Cnt = 0; i < count; i++) {
+
+        if (NK_Nil == Regions[i]) {
+            continue;
+        }
+
+        if ((NK_SSize64)Regions[i]->Size == Reqs[Cnt].Result) {
+            NK_PrivatedParser *Privated = PRIVATED(parsers[i]);
+            Regions[i]->Next = Privated->Regions;
+            Privated->Regions = Regions[i];
+        } else {
+            free(Regions[i]);
+            NK_Parse_Free(&parsers[i]);
+        }
+        Cnt++;
+    }
+
+_exit:
+    free(Reqs);
+    free(Regions);
+}
+
+/**
+ * 分配并初始化句柄，源由调用者填写。
+ */
+static NK_Parser *
+Elf_create(NK_UInt32 flags) {
+
     NK_PrivatedParser *Privated = NK_Nil;
     NK_Parser *Public = NK_Nil;
 
-    /**
-     * 参数检测。
-     */
-    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != elf, NK_Nil);
-
     /**
      * 初始化句柄。
      * 公有句柄的内存空间仅靠私有句柄的高位。
@@ -467,19 +3853,177 @@ NK_Parse_Create(const NK_PChar elf) {
     memset(Privated, 0, sizeof(NK_PrivatedParser) + sizeof(NK_Parser));
 
     /// 初始化模块私有句柄。
-    memcpy(Privated->Path, elf, strlen(elf));
-    Privated->Path[strlen(elf)] = '\0';
+    Privated->Flags = flags;
+    Privated->Fd = -1;
+    pthread_mutex_init(&Privated->Lock, NK_Nil);
+    pthread_mutex_init(&Privated->RegionLock, NK_Nil);
 
     /// 初始化模块公有句柄。
     Public->parse   = Elf_parse;
     Public->header  = Elf_header;
     Public->section = Elf_section;
     Public->symtab  = Elf_symtab;
+    Public->stats   = Elf_stats;
+    Public->span    = Elf_span;
+    Public->span_by_name = Elf_span_by_name;
+    Public->find_section = Elf_find_section;
+    Public->sections     = Elf_sections_begin;
+    Public->next_section = Elf_next_section;
+    Public->symbols      = Elf_symbols_begin;
+    Public->next_symbol  = Elf_next_symbol;
+    Public->segments     = Elf_segments;
+    Public->lookup_symbol = Elf_lookup_symbol;
+    Public->symbol_at = Elf_symbol_at;
+    Public->symbolize = Elf_symbolize;
 
     /// 返回模块公有句柄。
     return Public;
 }
 
+NK_Parser *
+NK_Parse_CreateEx(const NK_PChar elf, NK_UInt32 flags) {
+
+    NK_Parser *Public = NK_Nil;
+
+    /**
+     * 参数检测。
+     */
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != elf, NK_Nil);
+    NK_EXPECT_VERBOSE_RETURN_VAL(strlen(elf) < sizeof(((NK_PrivatedParser *)0)->Path), NK_Nil);
+
+    Public = Elf_create(flags);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, NK_Nil);
+
+    /// 记录源路径。
+    snprintf(PRIVATED(Public)->Path, sizeof(PRIVATED(Public)->Path), "%s", elf);
+
+    return Public;
+}
+
+NK_Parser *
+NK_Parse_CreateFromMemory(const NK_PVoid data, NK_Size64 size, NK_Boolean own) {
+
+    NK_Parser *Public = NK_Nil;
+
+    /**
+     * 参数检测。
+     */
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != data, NK_Nil);
+    NK_EXPECT_VERBOSE_RETURN_VAL(size > 0, NK_Nil);
+
+    Public = Elf_create(NK_PARSE_DEFAULT);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != Public, NK_Nil);
+
+    /// 直接引用调用者的内存，不拷贝。
+    PRIVATED(Public)->Src = data;
+    PRIVATED(Public)->Size = size;
+    PRIVATED(Public)->Owned = own;
+
+    return Public;
+}
+
+NK_Int
+NK_Parse_CreateBatch(const NK_PChar *elfs, NK_Int count, NK_UInt32 flags, NK_Parser **parsers) {
+
+    NK_ElfRange *Ranges = NK_Nil;
+    NK_Boolean *Loaded = NK_Nil;
+    NK_Int Parsed = 0;
+    NK_Int i;
+
+    /**
+     * 参数检测。
+     */
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != elfs, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(NK_Nil != parsers, -1);
+    NK_EXPECT_VERBOSE_RETURN_VAL(count >= 0, -1);
+
+    memset(parsers, 0, count * sizeof(NK_Parser *));
+
+    Ranges = calloc(count + 1, sizeof(NK_ElfRange));
+    Loaded = calloc(count + 1, sizeof(NK_Boolean));
+    NK_EXPECT_VERBOSE_JUMP(NK_Nil != Ranges && NK_Nil != Loaded, _exit);
+
+    /// 创建句柄并打开文件，命中解析缓存的无需读取。
+    for (i = 0; i < count; i++) {
+
+        NK_PrivatedParser *Privated = NK_Nil;
+
+        parsers[i] = NK_Parse_CreateEx(elfs[i], flags | NK_PARSE_LAZY);
+        NK_EXPECT_CONTINUE(NK_Nil != parsers[i]);
+        Privated = PRIVATED(parsers[i]);
+
+        if ((flags & NK_PARSE_CACHE) && 0 == Elf_cache_load(Privated)) {
+            continue;
+        }
+
+        Privated->Fd = NK_OpenFile(Privated->Path, &Privated->Size);
+        if (Privated->Fd < 0) {
+            NK_Parse_Free(&parsers[i]);
+            continue;
+        }
+
+        Privated->Source = NK_ELF_SRC_LAZY;
+        Loaded[i] = NK_True;
+        Ranges[i].Offset = 0;
+        Ranges[i].Size = Privated->Size < NK_ELF_EHDR_MAX ? Privated->Size : NK_ELF_EHDR_MAX;
+    }
+
+    /// 第一轮：所有文件的 ELF 头。
+    Elf_batch_fetch(parsers, Ranges, count);
+
+    /// 第二轮：所有文件的段表及段名窗口。
+    for (i = 0; i < count; i++) {
+
+        Ranges[i].Size = 0;
+        if (NK_Nil == parsers[i] || !Loaded[i]) {
+            continue;
+        }
+
+        /// 不是 ELF 文件的句柄被销毁。
+        if (0 != Elf_identify(PRIVATED(parsers[i])) || 0 != Elf_extend(PRIVATED(parsers[i]))) {
+            NK_Parse_Free(&parsers[i]);
+            continue;
+        }
+
+        if (0 != Elf_shdr_window(PRIVATED(parsers[i]), &Ranges[i])) {
+            Ranges[i].Size = 0;
+        }
+    }
+
+    Elf_batch_fetch(parsers, Ranges, count);
+
+    for (i = 0; i < count; i++) {
+
+        NK_EXPECT_CONTINUE(NK_Nil != parsers[i]);
+
+        /// 命中解析缓存的句柄已就绪。
+        if (NK_Nil != PRIVATED(parsers[i])->Cache) {
+            Parsed++;
+            continue;
+        }
+
+        if (0 != Elf_identify(PRIVATED(parsers[i])) || 0 != Elf_extend(PRIVATED(parsers[i]))) {
+            NK_Parse_Free(&parsers[i]);
+            continue;
+        }
+
+        if (NK_PARSE_HEADER != (flags & NK_PARSE_QUERIES)) {
+            Elf_sections(PRIVATED(parsers[i]));
+        }
+
+        /// 与 Elf_parse 相同，只预告 header/section/segments 时不写缓存。
+        if (Loaded[i] && (flags & NK_PARSE_CACHE) && !Elf_layout_only(flags)) {
+            Elf_cache_store(PRIVATED(parsers[i]));
+        }
+        Parsed++;
+    }
+
+_exit:
+    free(Ranges);
+    free(Loaded);
+    return Parsed;
+}
+
 NK_Int
 NK_Parse_Free(NK_Parser **parser) {
 
@@ -497,9 +4041,49 @@ NK_Parse_Free(NK_Parser **parser) {
 
     parser[0] = NK_Nil;
 
-    /// 释放私有数据。
-    if (Privated->Src)
-        free(Privated->Src);
+    /// 释放私有数据，调用者的内存仅在转移所有权时释放。
+    if (Privated->Src) {
+        if (NK_ELF_SRC_MAP == Privated->Source)
+            NK_UnmapBuffer(Privated->Src, Privated->Size);
+        else if (NK_ELF_SRC_HEAP == Privated->Source || Privated->Owned)
+            free(Privated->Src);
+    }
+
+    Elf_drop_regions(&Privated->Regions);
+    Elf_drop_regions(&Privated->Native);
+    if (Privated->Symtabs) {
+        NK_UInt32 i;
+        for (i = 0; i < Privated->Header.Shnum; i++)
+            free(Privated->Symtabs[i]);
+        free(Privated->Symtabs);
+    }
+    /// 命中解析缓存时段描述表在缓存映射内。
+    if (Privated->Sections && NK_Nil == Privated->Cache)
+        free(Privated->Sections);
+    free(Privated->Names);
+    if (Privated->Lookup) {
+        free(Privated->Lookup->Index.Slots);
+        free(Privated->Lookup);
+    }
+    if (Privated->Statics) {
+        free(Privated->Statics->Slots);
+        free(Privated->Statics);
+    }
+    if (Privated->Addresses) {
+        free(Privated->Addresses->Extents);
+        free(Privated->Addresses->Keys);
+        free(Privated->Addresses->Ranks);
+        free(Privated->Addresses);
+    }
+
+    if (Privated->Fd >= 0)
+        NK_CloseFile(Privated->Fd);
+
+    if (Privated->Cache)
+        NK_UnmapBuffer(Privated->Cache, Privated->CacheSize);
+
+    pthread_mutex_destroy(&Privated->Lock);
+    pthread_mutex_destroy(&Privated->RegionLock);
 
     /// 销毁私有句柄。
     free(Privated);
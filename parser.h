@@ -6,8 +6,155 @@
 
 NK_CPP_EXTERN_BEGIN
 
+/**
+ * 解析器选项，见 @ref NK_Parse_CreateEx()。
+ */
+#define NK_PARSE_DEFAULT    (0)
+/// 延迟加载：解析时仅读取 ELF 头与段表，段内容在首次访问时按需 pread。
+#define NK_PARSE_LAZY       (1 << 0)
+
+/**
+ * 预告将要调用的方法，解析器据此选择读取策略。\n
+ * 仅预告 header/section 时，解析至多发起两次小块读取（ELF 头、段表与段名），\n
+ * 未预告的方法依然可以调用，只是需要额外读取。
+ */
+#define NK_PARSE_HEADER     (1 << 1)
+#define NK_PARSE_SECTION    (1 << 2)
+#define NK_PARSE_SYMTAB     (1 << 3)
+#define NK_PARSE_SEGMENT    (1 << 5)
+#define NK_PARSE_QUERIES    (NK_PARSE_HEADER | NK_PARSE_SECTION | NK_PARSE_SYMTAB | NK_PARSE_SEGMENT)
+
+/**
+ * 使用持久化解析缓存，缓存目录由 @ref NK_Parse_SetCacheDir() 设置。\n
+ * 缓存以 (dev, inode, 长度, 修改时间, ELF 头散列) 标识源文件，\n
+ * 缓存的是解码结果：ELF 头、段描述表、段名与符号表的校验结果，跨字节序的文件另含转换后的符号表与散列表；\n
+ * 命中时直接使用映射的缓存文件，不再读取与解码段表，打开符号表时不再扫描与转换，\n
+ * 本机字节序的段内容仍取自源文件。\n
+ * 只预告 header/section/segments 时不写缓存，这些方法本身至多读取两次。
+ */
+#define NK_PARSE_CACHE      (1 << 4)
+
+/**
+ * 访问统计，见 @ref NK_Parser::stats。
+ */
+typedef struct NK_ParseStats {
+
+    /// 输出方法执行期间的主缺页次数（需要磁盘 I/O），按进程统计
+    NK_UInt64 MajorFaults;
+
+    /// 输出方法执行期间的次缺页次数
+    NK_UInt64 MinorFaults;
+
+    /// 发出的 madvise/posix_fadvise 提示次数
+    NK_UInt64 Advices;
+
+} NK_ParseStats;
+
+/**
+ * 段内容视图，直接指向映射或加载的 elf 源，不拷贝。\n
+ * 在解析器销毁前有效，调用者不得修改。
+ */
+typedef struct NK_ElfSpan {
+
+    /// 段内容，NOBITS 段为 NK_Nil
+    const NK_Void *Data;
+
+    /// 段长度
+    NK_Size64 Size;
+
+} NK_ElfSpan;
+
+/**
+ * 段描述，由 @ref NK_Parser::next_section 填写。
+ */
+typedef struct NK_ElfSectionInfo {
+
+    /// 段索引
+    NK_Int Index;
+
+    /// 段名，指向段表字符串表，以 '\0' 结尾，无效时为 ""
+    const NK_Char *Name;
+
+    NK_UInt32 Type;
+    NK_UInt64 Flags;
+    NK_UInt64 Addr;
+    NK_UInt64 Offset;
+    NK_UInt64 Size;
+    NK_UInt32 Link;
+    NK_UInt32 Info;
+    NK_UInt64 Addralign;
+    NK_UInt64 Entsize;
+
+} NK_ElfSectionInfo;
+
+/**
+ * 符号，由 @ref NK_Parser::next_symbol 填写，两种类别解码为同一结构。
+ */
+typedef struct NK_ElfSymbol {
+
+    /// 符号在符号表中的索引
+    NK_Size64 Index;
+
+    /// 符号名，指向符号字符串表，以 '\0' 结尾，无效时为 ""
+    const NK_Char *Name;
+
+    NK_UInt64 Value;
+    NK_UInt64 Size;
+
+    /// STT_*、STB_*、STV_*
+    NK_Byte Type;
+    NK_Byte Bind;
+    NK_Byte Visibility;
+
+    /// 所在段索引，SHN_XINDEX 已按扩展段索引表解析
+    NK_UInt32 Shndx;
+
+} NK_ElfSymbol;
+
+/**
+ * 批量按地址查找符号的结果，见 @ref NK_Parser::symbolize。
+ */
+typedef struct NK_ElfLocation {
+
+    /// 所在符号在符号表中的索引，地址不在任何符号内时为 -1
+    NK_Int64 Index;
+
+    /// 地址在符号内的偏移
+    NK_UInt64 Offset;
+
+    /// 符号名，视图，在解析器销毁前有效，未找到时为 ""
+    const NK_Char *Name;
+
+} NK_ElfLocation;
+
+/**
+ * 遍历游标，由调用者分配（通常在栈上），遍历过程不申请内存。\n
+ * 字段由解析器维护，调用者不得修改。
+ */
+typedef struct NK_ElfCursor {
+
+    /// 所遍历的符号表段索引，遍历段表时为 -1
+    NK_Int Table;
+
+    /// 下一项索引
+    NK_Size64 Next;
+
+    /// 总项数
+    NK_Size64 Count;
+
+    /// 内部使用
+    const NK_Void *Opaque;
+
+} NK_ElfCursor;
+
 #pragma pack(push, 4)
 
+/**
+ * 解析器。\n
+ * 并发：@ref parse 须在一个线程内完成；解析成功后，除 NK_Parse_Free() 外的各方法可被多个线程同时调用，\n
+ * 按需构建的段描述表、段名索引、符号表与读取的区间只构建一次，之后的读取无需加锁。\n
+ * 游标属于调用者，不应在线程间共享。
+ */
 typedef struct NK_Parser {
 #define NK_This struct NK_Parser *const
 
@@ -62,6 +209,244 @@ typedef struct NK_Parser {
     NK_Int
     (*symtab)(NK_This);
 
+    /**
+     * @brief
+     *  获取访问统计。\n
+     *  各输出方法按访问模式对所读区间发出 madvise/posix_fadvise 提示，\n
+     *  统计记录提示次数与方法执行期间的缺页次数，便于观察提示的效果。
+     *
+     * @param[out] stats
+     *  统计结果。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败。
+     */
+    NK_Int
+    (*stats)(NK_This, NK_ParseStats *stats);
+
+    /**
+     * @brief
+     *  按段索引获取段内容视图。\n
+     *  映射、整体加载或调用者内存的源直接返回源内地址；\n
+     *  延迟加载的源首次访问时读取该段；流式读取的源仅能访问解析时保留的段。
+     *
+     * @param[in] index
+     *  段索引。
+     *
+     * @param[out] span
+     *  段内容视图。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败，索引无效或段内容越出文件。
+     */
+    NK_Int
+    (*span)(NK_This, NK_Int index, NK_ElfSpan *span);
+
+    /**
+     * @brief
+     *  按段名获取段内容视图，见 @ref span。
+     *
+     * @param[in] name
+     *  段名，如 ".text"。
+     *
+     * @param[out] span
+     *  段内容视图。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败，段不存在。
+     */
+    NK_Int
+    (*span_by_name)(NK_This, const NK_PChar name, NK_ElfSpan *span);
+
+    /**
+     * @brief
+     *  按段名查找段索引。\n
+     *  首次调用时构建段名散列索引，之后每次查找为常数时间，\n
+     *  同名的段返回索引最小的一个。
+     *
+     * @param[in] name
+     *  段名，如 ".dynsym"。
+     *
+     * @retval >=0
+     *  段索引。
+     *
+     * @retval -1
+     *  失败，段不存在。
+     */
+    NK_Int
+    (*find_section)(NK_This, const NK_PChar name);
+
+    /**
+     * @brief
+     *  开始遍历段表。
+     *
+     * @param[out] cursor
+     *  游标，交给 @ref next_section 逐项读取。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败。
+     */
+    NK_Int
+    (*sections)(NK_This, NK_ElfCursor *cursor);
+
+    /**
+     * @brief
+     *  读取下一个段描述。
+     *
+     * @param[in,out] cursor
+     *  由 @ref sections 初始化的游标。
+     *
+     * @param[out] section
+     *  段描述，段名为视图，在解析器销毁前有效。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  遍历结束。
+     */
+    NK_Int
+    (*next_section)(NK_This, NK_ElfCursor *cursor, NK_ElfSectionInfo *section);
+
+    /**
+     * @brief
+     *  开始遍历一个符号表。\n
+     *  首次打开时准备符号表及其字符串表，之后的遍历直接解码，\n
+     *  通过校验的符号表逐项读取时不做边界检查。
+     *
+     * @param[in] index
+     *  SHT_SYMTAB 或 SHT_DYNSYM 段的索引，可由 @ref find_section 得到。
+     *
+     * @param[out] cursor
+     *  游标，交给 @ref next_symbol 逐项读取。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败，索引无效、不是符号表或符号表无法读取。
+     */
+    NK_Int
+    (*symbols)(NK_This, NK_Int index, NK_ElfCursor *cursor);
+
+    /**
+     * @brief
+     *  读取下一个符号。
+     *
+     * @param[in,out] cursor
+     *  由 @ref symbols 初始化的游标。
+     *
+     * @param[out] symbol
+     *  符号，符号名为视图，在解析器销毁前有效。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  遍历结束。
+     */
+    NK_Int
+    (*next_symbol)(NK_This, NK_ElfCursor *cursor, NK_ElfSymbol *symbol);
+
+    /**
+     * @brief
+     *  dump program headers 及段到程序段的映射。\n
+     *  映射按文件偏移与地址排序后扫描得到，不逐对比较段与程序段。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败。
+     */
+    NK_Int
+    (*segments)(NK_This);
+
+    /**
+     * @brief
+     *  按符号名查找符号，自动选用文件中最合适的散列表：\n
+     *  优先 .gnu.hash（DT_GNU_HASH），布隆过滤器排除多数不存在的符号，存在时只访问一条散列链；\n
+     *  其次 .hash（DT_HASH）；两者都没有时才在首次查找时为动态符号表构建索引。\n
+     *  动态符号中查不到时再查 .symtab，其索引在第一次需要时构建，\n
+     *  同名符号优先返回已定义的全局符号。\n
+     *  散列表在首次查找时准备，之后的查找无需加锁。\n
+     *  散列表中的未定义引用同样返回，其 Shndx 为 SHN_UNDEF。
+     *
+     * @param[in] name
+     *  符号名。
+     *
+     * @param[out] symbol
+     *  符号，符号名为视图，在解析器销毁前有效。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败，符号不存在或文件没有符号表。
+     */
+    NK_Int
+    (*lookup_symbol)(NK_This, const NK_PChar name, NK_ElfSymbol *symbol);
+
+    /**
+     * @brief
+     *  按地址查找所在的函数或变量。\n
+     *  查找 .symtab，没有时查找动态符号表，只考虑已定义的 STT_FUNC 与 STT_OBJECT 符号。\n
+     *  符号覆盖 [st_value, st_value + st_size)；st_size 为 0 时覆盖到下一个符号或所在段的末尾，且不超出包含它的符号。\n
+     *  同一地址有多个符号时优先返回有长度的全局符号；\n
+     *  符号相互嵌套时返回包含该地址、起始地址最近的一个，如地址在内层符号之后、外层符号之内时返回外层符号。\n
+     *  地址索引在首次查找时构建，之后的查找无需加锁，每次查找访问的缓存行数与符号数的对数成正比。\n
+     *  可重定位文件的符号值是段内偏移，不支持按地址查找。
+     *
+     * @param[in] address
+     *  虚拟地址。
+     *
+     * @param[out] symbol
+     *  符号，符号名为视图，在解析器销毁前有效；@ref address 在符号内的偏移为 address - symbol->Value。
+     *
+     * @retval 0
+     *  成功。
+     *
+     * @retval -1
+     *  失败，地址不在任何符号内或文件没有可用的符号表。
+     */
+    NK_Int
+    (*symbol_at)(NK_This, NK_UInt64 address, NK_ElfSymbol *symbol);
+
+    /**
+     * @brief
+     *  批量按地址查找符号，规则同 @ref symbol_at。\n
+     *  地址升序时与地址索引做一次归并，总代价与 地址数 + 符号数 成正比；\n
+     *  无序时先在内部做线性时间的基数排序，调用者无需排序，结果仍与输入一一对应；\n
+     *  符号较少（索引可常驻缓存）或地址远少于符号时改为逐个查找。\n
+     *  适合把大量采样地址一次解析完。
+     *
+     * @param[in] addresses
+     *  虚拟地址数组。
+     *
+     * @param[in] count
+     *  地址数。
+     *
+     * @param[out] locations
+     *  与 @ref addresses 一一对应的结果，由调用者分配。
+     *
+     * @return
+     *  成功返回所用符号表的段索引，失败返回 -1（文件没有可用的符号表时结果均为未找到）。
+     */
+    NK_Int
+    (*symbolize)(NK_This, const NK_UInt64 *addresses, NK_Size count, NK_ElfLocation *locations);
+
 #undef NK_This
 } NK_Parser;
 
@@ -69,11 +454,45 @@ typedef struct NK_Parser {
 
 
 /**
- * 创建 ELF 解析器。
+ * 设置解析缓存目录，NK_Nil 关闭缓存。\n
+ * 应在创建解析器之前调用。
+ */
+NK_API NK_Int
+NK_Parse_SetCacheDir(const NK_PChar dir);
+
+/**
+ * 创建 ELF 解析器，@ref elf 为 "-" 时从标准输入顺序读取。\n
+ * 流式读取在读到段表之前无法得知需要哪些段，段表通常位于文件末尾，\n
+ * 因此段表之前的内容（e_shoff 字节，通常接近文件长度）先暂存于内存，读入段表后只保留需要的段；\n
+ * 峰值内存约为文件长度，大文件宜先写入普通文件再解析。
  */
 NK_API NK_Parser *
 NK_Parse_Create(const NK_PChar elf);
 
+/**
+ * 创建 ELF 解析器，@ref flags 为 NK_PARSE_* 选项组合。
+ */
+NK_API NK_Parser *
+NK_Parse_CreateEx(const NK_PChar elf, NK_UInt32 flags);
+
+/**
+ * 基于调用者内存创建 ELF 解析器，解析时不拷贝、不访问文件。\n
+ * @ref own 为假时 @ref data 需在解析器销毁前保持有效；\n
+ * 为真时所有权转移给解析器，销毁时以 free() 释放，@ref data 需由 malloc() 分配。
+ */
+NK_API NK_Parser *
+NK_Parse_CreateFromMemory(const NK_PVoid data, NK_Size64 size, NK_Boolean own);
+
+/**
+ * 批量创建并解析 ELF 解析器，适用于扫描大量文件。\n
+ * 先为所有文件一次性提交 ELF 头的读取，再一次性提交段表（及段名窗口）的读取，\n
+ * Linux 上经由 io_uring 并发完成，不可用时退回到线程池。\n
+ * 返回的解析器已完成解析（延迟加载），无需也不能再调用 parse，段内容仍按需读取。\n
+ * 失败的文件对应 @ref parsers 项为 NK_Nil，返回成功的个数，参数错误返回 -1。
+ */
+NK_API NK_Int
+NK_Parse_CreateBatch(const NK_PChar *elfs, NK_Int count, NK_UInt32 flags, NK_Parser **parsers);
+
 /**
  * 销毁 ELF 解析器。
  */
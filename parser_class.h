@@ -0,0 +1,225 @@
+/**
+ * 按 ELF 类别生成的解码实现，由 parser.c 在 ELF_CLASS 为 32、64 时各包含一次，\n
+ * 没有包含保护，不得单独包含。\n
+ * 文件内的类型、宏与函数名经 ElfW()/ELFW()/ElfN() 展开为对应类别的版本，\n
+ * 同一份代码生成两套实现，循环内直接按该类别的结构布局访问字段。
+ */
+
+#ifndef ELF_CLASS
+#error "parser_class.h is included by parser.c with ELF_CLASS defined"
+#endif
+
+/**
+ * 字段长度。
+ */
+#define NK_ELF_FIELD(__type, __member) sizeof(((__type *)0)->__member)
+
+/**
+ * 各结构的字段布局，跨字节序时按此整体转换，字段顺序与结构定义一致。
+ */
+static const NK_Byte ElfN(Elf_EhdrFields)[] = {
+    NK_ELF_FIELD(ElfW(Ehdr), e_ident),      NK_ELF_FIELD(ElfW(Ehdr), e_type),
+    NK_ELF_FIELD(ElfW(Ehdr), e_machine),    NK_ELF_FIELD(ElfW(Ehdr), e_version),
+    NK_ELF_FIELD(ElfW(Ehdr), e_entry),      NK_ELF_FIELD(ElfW(Ehdr), e_phoff),
+    NK_ELF_FIELD(ElfW(Ehdr), e_shoff),      NK_ELF_FIELD(ElfW(Ehdr), e_flags),
+    NK_ELF_FIELD(ElfW(Ehdr), e_ehsize),     NK_ELF_FIELD(ElfW(Ehdr), e_phentsize),
+    NK_ELF_FIELD(ElfW(Ehdr), e_phnum),      NK_ELF_FIELD(ElfW(Ehdr), e_shentsize),
+    NK_ELF_FIELD(ElfW(Ehdr), e_shnum),      NK_ELF_FIELD(ElfW(Ehdr), e_shstrndx),
+};
+
+static const NK_Byte ElfN(Elf_ShdrFields)[] = {
+    NK_ELF_FIELD(ElfW(Shdr), sh_name),      NK_ELF_FIELD(ElfW(Shdr), sh_type),
+    NK_ELF_FIELD(ElfW(Shdr), sh_flags),     NK_ELF_FIELD(ElfW(Shdr), sh_addr),
+    NK_ELF_FIELD(ElfW(Shdr), sh_offset),    NK_ELF_FIELD(ElfW(Shdr), sh_size),
+    NK_ELF_FIELD(ElfW(Shdr), sh_link),      NK_ELF_FIELD(ElfW(Shdr), sh_info),
+    NK_ELF_FIELD(ElfW(Shdr), sh_addralign), NK_ELF_FIELD(ElfW(Shdr), sh_entsize),
+};
+
+#if 32 == ELF_CLASS
+static const NK_Byte ElfN(Elf_PhdrFields)[] = {
+    NK_ELF_FIELD(ElfW(Phdr), p_type),       NK_ELF_FIELD(ElfW(Phdr), p_offset),
+    NK_ELF_FIELD(ElfW(Phdr), p_vaddr),      NK_ELF_FIELD(ElfW(Phdr), p_paddr),
+    NK_ELF_FIELD(ElfW(Phdr), p_filesz),     NK_ELF_FIELD(ElfW(Phdr), p_memsz),
+    NK_ELF_FIELD(ElfW(Phdr), p_flags),      NK_ELF_FIELD(ElfW(Phdr), p_align),
+};
+
+static const NK_Byte ElfN(Elf_SymFields)[] = {
+    NK_ELF_FIELD(ElfW(Sym), st_name),       NK_ELF_FIELD(ElfW(Sym), st_value),
+    NK_ELF_FIELD(ElfW(Sym), st_size),       NK_ELF_FIELD(ElfW(Sym), st_info),
+    NK_ELF_FIELD(ElfW(Sym), st_other),      NK_ELF_FIELD(ElfW(Sym), st_shndx),
+};
+#else
+static const NK_Byte ElfN(Elf_PhdrFields)[] = {
+    NK_ELF_FIELD(ElfW(Phdr), p_type),       NK_ELF_FIELD(ElfW(Phdr), p_flags),
+    NK_ELF_FIELD(ElfW(Phdr), p_offset),     NK_ELF_FIELD(ElfW(Phdr), p_vaddr),
+    NK_ELF_FIELD(ElfW(Phdr), p_paddr),      NK_ELF_FIELD(ElfW(Phdr), p_filesz),
+    NK_ELF_FIELD(ElfW(Phdr), p_memsz),      NK_ELF_FIELD(ElfW(Phdr), p_align),
+};
+
+static const NK_Byte ElfN(Elf_SymFields)[] = {
+    NK_ELF_FIELD(ElfW(Sym), st_name),       NK_ELF_FIELD(ElfW(Sym), st_info),
+    NK_ELF_FIELD(ElfW(Sym), st_other),      NK_ELF_FIELD(ElfW(Sym), st_shndx),
+    NK_ELF_FIELD(ElfW(Sym), st_value),      NK_ELF_FIELD(ElfW(Sym), st_size),
+};
+#endif
+
+static const NK_Byte ElfN(Elf_AddrFields)[] = {sizeof(ElfW(Addr))};
+
+#undef NK_ELF_FIELD
+
+/**
+ * 解码 ELF 头。
+ */
+static NK_Void
+ElfN(Elf_ehdr)(const NK_Void *Raw, NK_ElfHeader *Header) {
+
+    const ElfW(Ehdr) *Ehdr = Raw;
+
+    memcpy(Header->Ident, Ehdr->e_ident, EI_NIDENT);
+    Header->Type        = Ehdr->e_type;
+    Header->Machine     = Ehdr->e_machine;
+    Header->Version     = Ehdr->e_version;
+    Header->Entry       = Ehdr->e_entry;
+    Header->Phoff       = Ehdr->e_phoff;
+    Header->Shoff       = Ehdr->e_shoff;
+    Header->Flags       = Ehdr->e_flags;
+    Header->Ehsize      = Ehdr->e_ehsize;
+    Header->Phentsize   = Ehdr->e_phentsize;
+    Header->Phnum       = Ehdr->e_phnum;
+    Header->Shentsize   = Ehdr->e_shentsize;
+    Header->Shnum       = Ehdr->e_shnum;
+    Header->Shstrndx    = Ehdr->e_shstrndx;
+}
+
+/**
+ * 解码段表中第 @ref Index 项。
+ */
+static NK_Void
+ElfN(Elf_shdr)(const NK_Void *Table, NK_Size64 Index, NK_ElfShdr *Shdr) {
+
+    const ElfW(Shdr) *Raw = (const ElfW(Shdr) *)Table + Index;
+
+    Shdr->Name      = Raw->sh_name;
+    Shdr->Type      = Raw->sh_type;
+    Shdr->Flags     = Raw->sh_flags;
+    Shdr->Addr      = Raw->sh_addr;
+    Shdr->Offset    = Raw->sh_offset;
+    Shdr->Size      = Raw->sh_size;
+    Shdr->Link      = Raw->sh_link;
+    Shdr->Info      = Raw->sh_info;
+    Shdr->Addralign = Raw->sh_addralign;
+    Shdr->Entsize   = Raw->sh_entsize;
+}
+
+/**
+ * 解码程序头表中第 @ref Index 项。
+ */
+static NK_Void
+ElfN(Elf_phdr)(const NK_Void *Table, NK_Size64 Index, NK_ElfPhdr *Phdr) {
+
+    const ElfW(Phdr) *Raw = (const ElfW(Phdr) *)Table + Index;
+
+    Phdr->Type      = Raw->p_type;
+    Phdr->Flags     = Raw->p_flags;
+    Phdr->Offset    = Raw->p_offset;
+    Phdr->Vaddr     = Raw->p_vaddr;
+    Phdr->Paddr     = Raw->p_paddr;
+    Phdr->Filesz    = Raw->p_filesz;
+    Phdr->Memsz     = Raw->p_memsz;
+    Phdr->Align     = Raw->p_align;
+}
+
+/**
+ * 扫描符号表，返回最大的符号名偏移，循环内没有分支。
+ */
+static NK_UInt64
+ElfN(Elf_scan)(const NK_Void *Symbols, NK_Size64 Cnt, NK_Boolean *Xneeded) {
+
+    const ElfW(Sym) *Sym = Symbols;
+    NK_UInt64 MaxName = 0;
+    NK_UInt32 Xindex = 0;
+    NK_Size64 i;
+
+    for (i = 0; i < Cnt; i++) {
+        MaxName = Sym[i].st_name > MaxName ? Sym[i].st_name : MaxName;
+        Xindex |= (SHN_XINDEX == Sym[i].st_shndx);
+    }
+
+    *Xneeded = Xindex ? NK_True : NK_False;
+
+    return MaxName;
+}
+
+/**
+ * 解码第 @ref Index 个符号，通过校验的符号表直接访问符号名与扩展段索引，否则逐项检查。
+ */
+static NK_Void
+ElfN(Elf_symbol)(const NK_ElfSymtab *Symtab, NK_Size64 Index, NK_ElfSymbol *Symbol) {
+
+    const ElfW(Sym) *Sym = (const ElfW(Sym) *)Symtab->Sym + Index;
+
+    Symbol->Index       = Index;
+    Symbol->Value       = Sym->st_value;
+    Symbol->Size        = Sym->st_size;
+    Symbol->Type        = ELFW(ST_TYPE)(Sym->st_info);
+    Symbol->Bind        = ELFW(ST_BIND)(Sym->st_info);
+    Symbol->Visibility  = ELFW(ST_VISIBILITY)(Sym->st_other);
+    Symbol->Shndx       = Sym->st_shndx;
+
+    if (Symtab->Checked) {
+
+        if (SHN_XINDEX == Symbol->Shndx)
+            Symbol->Shndx = Symtab->Xindex[Index];
+
+        /// 从"符号字符串表"找出符号名
+        Symbol->Name = Symtab->Strtab + Sym->st_name;
+        return;
+    }
+
+    if (SHN_XINDEX == Symbol->Shndx && Index < Symtab->Xcnt)
+        Symbol->Shndx = Symtab->Xindex[Index];
+
+    /// 符号名需以 '\0' 结尾并落在字符串表内。
+    Symbol->Name = "";
+    if (Sym->st_name < Symtab->StrSize
+        && NK_Nil != memchr(Symtab->Strtab + Sym->st_name, '\0', Symtab->StrSize - Sym->st_name)) {
+        Symbol->Name = Symtab->Strtab + Sym->st_name;
+    }
+}
+
+/**
+ * GNU 散列表的布隆过滤器检查，两个散列位均置位时符号才可能存在。\n
+ * 字数为 2 的幂，移位小于 32，均已由 @ref Elf_load_gnu_hash() 校验。
+ */
+static NK_Boolean
+ElfN(Elf_bloom)(const NK_ElfLookup *Lookup, NK_UInt32 Hash) {
+
+    const NK_UInt32 Bits = sizeof(ElfW(Addr)) * 8;
+    ElfW(Addr) Word = ((const ElfW(Addr) *)Lookup->Bloom)[(Hash / Bits) & (Lookup->BloomSize - 1)];
+    ElfW(Addr) Mask = ((ElfW(Addr))1 << (Hash % Bits)) | ((ElfW(Addr))1 << ((Hash >> Lookup->BloomShift) % Bits));
+
+    return Mask == (Word & Mask) ? NK_True : NK_False;
+}
+
+/**
+ * 本类别的解码实现。
+ */
+static const NK_ElfClass ElfN(Elf_Class) = {
+    .Class      = NK_ELF_PASTE(ELFCLASS, ELF_CLASS),
+    .Ehsize     = sizeof(ElfW(Ehdr)),
+    .Shentsize  = sizeof(ElfW(Shdr)),
+    .Phentsize  = sizeof(ElfW(Phdr)),
+    .Symentsize = sizeof(ElfW(Sym)),
+    .Addrsize   = sizeof(ElfW(Addr)),
+    .EhdrLayout = {ElfN(Elf_EhdrFields), sizeof(ElfN(Elf_EhdrFields))},
+    .ShdrLayout = {ElfN(Elf_ShdrFields), sizeof(ElfN(Elf_ShdrFields))},
+    .PhdrLayout = {ElfN(Elf_PhdrFields), sizeof(ElfN(Elf_PhdrFields))},
+    .SymLayout  = {ElfN(Elf_SymFields), sizeof(ElfN(Elf_SymFields))},
+    .AddrLayout = {ElfN(Elf_AddrFields), sizeof(ElfN(Elf_AddrFields))},
+    .ehdr       = ElfN(Elf_ehdr),
+    .shdr       = ElfN(Elf_shdr),
+    .phdr       = ElfN(Elf_phdr),
+    .scan       = ElfN(Elf_scan),
+    .symbol     = ElfN(Elf_symbol),
+    .bloom      = ElfN(Elf_bloom),
+};
@@ -0,0 +1,1230 @@
+/**
+ * make check 的测试驱动：解析 make 生成的夹具，与已知结果比较。\n
+ * 用法：check <夹具目录> [batch]，全部通过时返回 0，否则逐条输出失败的检查；\n
+ * 带 batch 时只检查批量解析。
+ */
+
+#include <parser.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <elf.h>
+
+/// 当前夹具，用于输出失败位置。
+static const NK_Char *Fixture = "";
+
+static NK_Int Failures = 0;
+
+#define CHECK(__cond) do { \
+    if (!(__cond)) { \
+        fprintf(stderr, "%s:%d: [%s] CHECK(%s) failed\n", __FILE__, __LINE__, Fixture, #__cond); \
+        Failures++; \
+    } \
+} while (0)
+
+/**
+ * 创建并解析夹具，失败返回 NK_Nil。
+ */
+static NK_Parser *
+open_fixture(const NK_Char *dir, const NK_Char *name, NK_UInt32 flags) {
+
+    static NK_Char Path[1024];
+    NK_Parser *parser = NK_Nil;
+
+    snprintf(Path, sizeof(Path), "%s/%s", dir, name);
+    Fixture = name;
+
+    parser = NK_Parse_CreateEx(Path, flags);
+    CHECK(NK_Nil != parser);
+    if (NK_Nil == parser) {
+        return NK_Nil;
+    }
+
+    CHECK(0 == parser->parse(parser));
+
+    return parser;
+}
+
+/**
+ * 把夹具整体读入调用者的缓冲区，失败返回 NK_Nil。
+ */
+static NK_PByte
+load_fixture(const NK_Char *dir, const NK_Char *name, NK_Size64 *size) {
+
+    NK_Char Path[1024];
+    NK_PByte Data = NK_Nil;
+    FILE *fp = NK_Nil;
+    long Len = -1;
+
+    snprintf(Path, sizeof(Path), "%s/%s", dir, name);
+    Fixture = name;
+
+    fp = fopen(Path, "rb");
+    CHECK(NK_Nil != fp);
+    if (NK_Nil == fp)
+        return NK_Nil;
+
+    if (0 == fseek(fp, 0, SEEK_END) && (Len = ftell(fp)) > 0 && 0 == fseek(fp, 0, SEEK_SET)) {
+        Data = malloc((size_t)Len);
+        if (NK_Nil != Data && (size_t)Len != fread(Data, 1, (size_t)Len, fp)) {
+            free(Data);
+            Data = NK_Nil;
+        }
+    }
+    fclose(fp);
+
+    CHECK(NK_Nil != Data);
+    *size = (NK_Size64)Len;
+    return Data;
+}
+
+/**
+ * 第一个 @ref type 类型的段索引，没有时返回 -1。
+ */
+static NK_Int
+find_type(NK_Parser *parser, NK_UInt32 type) {
+
+    NK_ElfCursor cursor;
+    NK_ElfSectionInfo section;
+
+    if (0 != parser->sections(parser, &cursor)) {
+        return -1;
+    }
+
+    while (0 == parser->next_section(parser, &cursor, &section)) {
+        if (type == section.Type)
+            return (NK_Int)section.Index;
+    }
+
+    return -1;
+}
+
+/**
+ * 第 @ref index 段的段描述，没有时返回 -1。
+ */
+static NK_Int
+section_info(NK_Parser *parser, NK_Int index, NK_ElfSectionInfo *section) {
+
+    NK_ElfCursor cursor;
+
+    if (index < 0 || 0 != parser->sections(parser, &cursor)) {
+        return -1;
+    }
+
+    while (0 == parser->next_section(parser, &cursor, section)) {
+        if (index == section->Index)
+            return 0;
+    }
+
+    return -1;
+}
+
+/**
+ * 按名查找 fixture.c 导出的符号。
+ */
+static NK_Void
+check_names(NK_Parser *parser) {
+
+    static const struct {
+        const NK_Char *Name;
+        NK_Byte Type;
+        NK_UInt64 Size;
+    } Known[] = {
+        {"alpha",   STT_FUNC,   0},
+        {"delta",   STT_FUNC,   0},
+        {"beta",    STT_OBJECT, sizeof(int)},
+        {"gamma_v", STT_OBJECT, sizeof(int) * 4},
+    };
+    NK_ElfSymbol symbol;
+    NK_Size i;
+
+    for (i = 0; i < sizeof(Known) / sizeof(Known[0]); i++) {
+        CHECK(0 == parser->lookup_symbol(parser, (NK_PChar)Known[i].Name, &symbol));
+        CHECK(0 == strcmp(Known[i].Name, symbol.Name));
+        CHECK(Known[i].Type == symbol.Type);
+        CHECK(STB_GLOBAL == symbol.Bind);
+        CHECK(SHN_UNDEF != symbol.Shndx);
+        CHECK(0 == Known[i].Size || Known[i].Size == symbol.Size);
+    }
+
+    CHECK(-1 == parser->lookup_symbol(parser, "no_such_symbol", &symbol));
+    CHECK(-1 == parser->lookup_symbol(parser, "", &symbol));
+}
+
+/**
+ * 只有 .gnu.hash 的共享库。
+ */
+static NK_Void
+check_gnu_hash(const NK_Char *dir) {
+
+    NK_Parser *parser = open_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(find_type(parser, SHT_GNU_HASH) >= 0);
+    CHECK(find_type(parser, SHT_HASH) < 0);
+    check_names(parser);
+
+    NK_Parse_Free(&parser);
+}
+
+/**
+ * 只有 .hash（DT_HASH）的共享库，查找不得依赖 .gnu.hash。
+ */
+static NK_Void
+check_sysv_hash(const NK_Char *dir) {
+
+    NK_Parser *parser = open_fixture(dir, "fixture_sysv.so", NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(find_type(parser, SHT_HASH) >= 0);
+    CHECK(find_type(parser, SHT_GNU_HASH) < 0);
+    check_names(parser);
+
+    NK_Parse_Free(&parser);
+}
+
+/**
+ * GNU 散列表损坏（布隆过滤器移位不小于 32）且没有 SysV 散列表时，\n
+ * 按名查找退回到为动态符号表构建的索引；去掉了 .symtab 的夹具不会由 .symtab 兜底。
+ */
+static NK_Void
+check_bad_gnu_hash(const NK_Char *dir) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_PByte Data = NK_Nil;
+    NK_Size64 Size = 0;
+    NK_ElfCursor cursor;
+    NK_ElfSectionInfo section;
+    NK_UInt64 Offset = 0;
+    NK_UInt32 Shift = 40;
+
+    Data = load_fixture(dir, "fixture_strip.so", &Size);
+    if (NK_Nil == Data)
+        return;
+
+    parser = NK_Parse_CreateFromMemory(Data, Size, NK_False);
+    CHECK(NK_Nil != parser && 0 == parser->parse(parser));
+    if (NK_Nil != parser) {
+        CHECK(0 == parser->sections(parser, &cursor));
+        while (0 == parser->next_section(parser, &cursor, &section)) {
+            if (SHT_GNU_HASH == section.Type)
+                Offset = section.Offset;
+        }
+        CHECK(-1 == find_type(parser, SHT_HASH) && -1 == find_type(parser, SHT_SYMTAB));
+        NK_Parse_Free(&parser);
+    }
+
+    CHECK(0 != Offset && Offset + 16 <= Size);
+    if (0 != Offset && Offset + 16 <= Size) {
+        memcpy(Data + Offset + 12, &Shift, sizeof(Shift));
+        parser = NK_Parse_CreateFromMemory(Data, Size, NK_False);
+        CHECK(NK_Nil != parser && 0 == parser->parse(parser));
+        if (NK_Nil != parser) {
+            check_names(parser);
+            NK_Parse_Free(&parser);
+        }
+    }
+
+    free(Data);
+}
+
+/**
+ * 局部函数只能经 .symtab 的符号名索引找到，去掉 .symtab 后查找失败，导出的符号不受影响。
+ */
+static NK_Void
+check_statics(const NK_Char *dir) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfSymbol symbol;
+
+    parser = open_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    if (NK_Nil != parser) {
+        CHECK(find_type(parser, SHT_SYMTAB) >= 0);
+        CHECK(0 == parser->lookup_symbol(parser, "hidden_s", &symbol));
+        CHECK(0 == strcmp("hidden_s", symbol.Name));
+        CHECK(STT_FUNC == symbol.Type && STB_LOCAL == symbol.Bind);
+        CHECK(SHN_UNDEF != symbol.Shndx);
+        NK_Parse_Free(&parser);
+    }
+
+    parser = open_fixture(dir, "fixture_strip.so", NK_PARSE_DEFAULT);
+    if (NK_Nil != parser) {
+        CHECK(find_type(parser, SHT_SYMTAB) < 0);
+        CHECK(-1 == parser->lookup_symbol(parser, "hidden_s", &symbol));
+        check_names(parser);
+        NK_Parse_Free(&parser);
+    }
+}
+
+/**
+ * 按地址查找嵌套的符号：内层之后、外层之内的地址属于外层，\n
+ * 零长度的 label 覆盖到 outer 的末尾，没有 .symtab 时该范围属于 outer。
+ */
+static NK_Void
+check_addresses(NK_Parser *parser, NK_Boolean statics) {
+
+    static const struct {
+        NK_UInt64 Offset;
+        const NK_Char *Name;
+        NK_UInt64 Start;
+    } Known[] = {
+        {0x00,  "outer",    0x00},
+        {0x10,  "inner",    0x10},
+        {0x1f,  "inner",    0x10},
+        {0x20,  "outer",    0x00},
+        {0x5f,  "outer",    0x00},
+        {0x60,  "label",    0x60},
+        {0xff,  "label",    0x60},
+    };
+    NK_ElfSymbol outer, symbol;
+    NK_Size i;
+
+    CHECK(0 == parser->lookup_symbol(parser, "outer", &outer));
+    CHECK(0x100 == outer.Size);
+
+    for (i = 0; i < sizeof(Known) / sizeof(Known[0]); i++) {
+
+        const NK_Char *Name = Known[i].Name;
+        NK_UInt64 Start = Known[i].Start;
+
+        if (!statics && 0 == strcmp("label", Name)) {
+            Name = "outer";
+            Start = 0;
+        }
+
+        CHECK(0 == parser->symbol_at(parser, outer.Value + Known[i].Offset, &symbol));
+        CHECK(0 == strcmp(Name, symbol.Name));
+        CHECK(outer.Value + Start == symbol.Value);
+    }
+
+    /// ELF 头所在的地址不属于任何符号。
+    CHECK(-1 == parser->symbol_at(parser, 0, &symbol));
+}
+
+static NK_Void
+check_nested(const NK_Char *dir) {
+
+    NK_Parser *parser = NK_Nil;
+
+    parser = open_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    if (NK_Nil != parser) {
+        check_addresses(parser, NK_True);
+        NK_Parse_Free(&parser);
+    }
+
+    parser = open_fixture(dir, "fixture_strip.so", NK_PARSE_DEFAULT);
+    if (NK_Nil != parser) {
+        check_addresses(parser, NK_False);
+        NK_Parse_Free(&parser);
+    }
+}
+
+/**
+ * 批量查找小夹具：无序且有重复的地址，结果与输入一一对应。
+ */
+static NK_Void
+check_symbolize_small(const NK_Char *dir) {
+
+    static const struct {
+        NK_UInt64 Offset;
+        const NK_Char *Name;
+        NK_UInt64 Within;
+    } Known[] = {
+        {0x50,  "outer",    0x50},
+        {0x12,  "inner",    0x02},
+        {0x65,  "label",    0x05},
+        {0x50,  "outer",    0x50},
+        {0x00,  "outer",    0x00},
+        {0x12,  "inner",    0x02},
+    };
+    NK_Size Cnt = sizeof(Known) / sizeof(Known[0]);
+    NK_UInt64 addresses[sizeof(Known) / sizeof(Known[0]) + 1];
+    NK_ElfLocation locations[sizeof(Known) / sizeof(Known[0]) + 1];
+    NK_Parser *parser = NK_Nil;
+    NK_ElfSymbol outer;
+    NK_Size i;
+
+    parser = open_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(0 == parser->lookup_symbol(parser, "outer", &outer));
+    for (i = 0; i < Cnt; i++) {
+        addresses[i] = outer.Value + Known[i].Offset;
+    }
+    /// 不属于任何符号的地址。
+    addresses[Cnt] = 0;
+
+    CHECK(find_type(parser, SHT_SYMTAB) == parser->symbolize(parser, addresses, Cnt + 1, locations));
+    for (i = 0; i < Cnt; i++) {
+        CHECK(locations[i].Index >= 0);
+        CHECK(0 == strcmp(Known[i].Name, locations[i].Name));
+        CHECK(Known[i].Within == locations[i].Offset);
+    }
+    CHECK(-1 == locations[Cnt].Index);
+    CHECK(0 == strcmp("", locations[Cnt].Name));
+
+    /// 相同的地址得到相同的结果。
+    CHECK(locations[0].Index == locations[3].Index);
+    CHECK(locations[1].Index == locations[5].Index);
+
+    NK_Parse_Free(&parser);
+}
+
+/**
+ * 按 fn0 的地址推出 @ref address 所在的 fnN 与偏移，比较批量查找的结果。
+ */
+static NK_Void
+check_many_location(NK_UInt64 base, NK_UInt64 address, const NK_ElfLocation *location) {
+
+    NK_Char Name[32];
+
+    snprintf(Name, sizeof(Name), "fn%llu", (unsigned long long)((address - base) / 4));
+    CHECK(0 == strcmp(Name, location->Name));
+    CHECK((address - base) % 4 == location->Offset);
+}
+
+static int
+cmp_address(const void *a, const void *b) {
+
+    NK_UInt64 A = *(const NK_UInt64 *)a, B = *(const NK_UInt64 *)b;
+    return A < B ? -1 : (A > B ? 1 : 0);
+}
+
+/**
+ * 批量查找大夹具：地址多于符号数的 1/8 且无序时先排序再归并，有序时直接归并。\n
+ * 一半地址在另一半中重复出现。
+ */
+static NK_Void
+check_symbolize_many(const NK_Char *dir, const NK_Char *name) {
+
+    const NK_Size Cnt = 40000;
+    NK_UInt64 *addresses = NK_Nil;
+    NK_ElfLocation *locations = NK_Nil;
+    NK_Parser *parser = NK_Nil;
+    NK_ElfSymbol base;
+    NK_Int pass;
+    NK_Size i;
+
+    parser = open_fixture(dir, name, NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    addresses = malloc(sizeof(NK_UInt64) * Cnt);
+    locations = malloc(sizeof(NK_ElfLocation) * Cnt);
+    CHECK(NK_Nil != addresses && NK_Nil != locations);
+    CHECK(0 == parser->lookup_symbol(parser, "fn0", &base));
+
+    if (NK_Nil != addresses && NK_Nil != locations) {
+
+        for (i = 0; i < Cnt / 2; i++) {
+            addresses[i] = base.Value + (i * 7919) % (Cnt * 4);
+            addresses[Cnt - 1 - i] = addresses[i];
+        }
+
+        for (pass = 0; pass < 2; pass++) {
+
+            CHECK(find_type(parser, SHT_SYMTAB) == parser->symbolize(parser, addresses, Cnt, locations));
+            for (i = 0; i < Cnt; i++) {
+                check_many_location(base.Value, addresses[i], &locations[i]);
+            }
+
+            /// 第二遍输入有序。
+            qsort(addresses, Cnt, sizeof(NK_UInt64), cmp_address);
+        }
+    }
+
+    free(addresses);
+    free(locations);
+    NK_Parse_Free(&parser);
+}
+
+/**
+ * 从管道顺序读取夹具：标准输入不可定位，解析走流式路径。
+ */
+static NK_Void
+check_stream(const NK_Char *dir) {
+
+    NK_Char Command[1024];
+    NK_Parser *parser = NK_Nil;
+    FILE *pipe = NK_Nil;
+    NK_Int saved = -1;
+
+    snprintf(Command, sizeof(Command), "cat %s/fixture_gnu.so", dir);
+    Fixture = "fixture_gnu.so (stdin)";
+
+    pipe = popen(Command, "r");
+    CHECK(NK_Nil != pipe);
+    if (NK_Nil == pipe)
+        return;
+
+    saved = dup(STDIN_FILENO);
+    CHECK(saved >= 0 && dup2(fileno(pipe), STDIN_FILENO) >= 0);
+
+    parser = NK_Parse_Create("-");
+    CHECK(NK_Nil != parser);
+    if (NK_Nil != parser) {
+        CHECK(0 == parser->parse(parser));
+        check_names(parser);
+        check_addresses(parser, NK_True);
+        NK_Parse_Free(&parser);
+    }
+
+    if (saved >= 0) {
+        dup2(saved, STDIN_FILENO);
+        close(saved);
+    }
+    pclose(pipe);
+}
+
+/**
+ * 用解析缓存解析夹具并检查名字、地址与 .symtab 查找。
+ */
+static NK_Void
+check_cached(const NK_Char *dir, const NK_Char *name, NK_UInt32 flags) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfSymbol symbol;
+
+    parser = open_fixture(dir, name, flags | NK_PARSE_CACHE);
+    if (NK_Nil != parser) {
+        check_names(parser);
+        check_addresses(parser, NK_True);
+        CHECK(0 == parser->lookup_symbol(parser, "hidden_s", &symbol));
+        CHECK(parser->find_section(parser, ".dynsym") > 0);
+        NK_Parse_Free(&parser);
+    }
+}
+
+/**
+ * 解析缓存：首次解析写入缓存，再次解析命中缓存，结果不变；\n
+ * 只预告段表方法时不写缓存；截断的缓存文件被忽略并重写。
+ */
+static NK_Void
+check_cache_fixture(const NK_Char *dir, const NK_Char *name, NK_UInt32 flags) {
+
+    NK_Char Source[1024];
+    NK_Char Cache[1024];
+    NK_Char Path[2048];
+    NK_Parser *parser = NK_Nil;
+    struct stat Stat;
+    ino_t Inode = 0;
+
+    snprintf(Source, sizeof(Source), "%s/%s", dir, name);
+    snprintf(Cache, sizeof(Cache), "%s/cache", dir);
+    CHECK(0 == stat(Source, &Stat));
+
+    /// 与 Elf_cache_path 的命名一致。
+    snprintf(Path, sizeof(Path), "%s/%016llx-%016llx.nkc", Cache
+        , (unsigned long long)Stat.st_dev, (unsigned long long)Stat.st_ino);
+    unlink(Path);
+
+    CHECK(0 == NK_Parse_SetCacheDir(Cache));
+
+    parser = open_fixture(dir, name, NK_PARSE_SECTION | NK_PARSE_CACHE);
+    if (NK_Nil != parser) {
+        CHECK(find_type(parser, SHT_SYMTAB) > 0);
+        NK_Parse_Free(&parser);
+    }
+    CHECK(0 != access(Path, F_OK));
+
+    /// 首次写入缓存。
+    check_cached(dir, name, flags);
+    CHECK(0 == stat(Path, &Stat));
+    Inode = Stat.st_ino;
+
+    /// 命中缓存时不再重写，原子替换会换掉缓存文件的 inode。
+    check_cached(dir, name, flags);
+    CHECK(0 == stat(Path, &Stat));
+    CHECK(Inode == Stat.st_ino);
+
+    /// 损坏的缓存不被使用，解析照常并重写缓存。
+    CHECK(0 == truncate(Path, 100));
+    check_cached(dir, name, flags);
+    CHECK(0 == stat(Path, &Stat));
+    CHECK(Inode != Stat.st_ino && Stat.st_size > 100);
+
+    NK_Parse_SetCacheDir(NK_Nil);
+}
+
+static NK_Void
+check_cache(const NK_Char *dir) {
+
+    check_cache_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    check_cache_fixture(dir, "fixture_gnu.so", NK_PARSE_LAZY);
+
+    /// 跨字节序的文件缓存转换后的符号表与散列表。
+    check_cache_fixture(dir, "fixture_be.so", NK_PARSE_DEFAULT);
+}
+
+/**
+ * 大端夹具（elfswap 由小端夹具改写）：名字、地址与批量查找的结果与小端一致。
+ */
+static NK_Void
+check_big_endian(const NK_Char *dir) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfSymbol symbol;
+
+    parser = open_fixture(dir, "fixture_be.so", NK_PARSE_DEFAULT);
+    if (NK_Nil != parser) {
+        check_names(parser);
+        check_addresses(parser, NK_True);
+
+        /// GNU 散列表的 bloom 字与 .symtab 均经过转换。
+        CHECK(find_type(parser, SHT_GNU_HASH) > 0);
+        CHECK(0 == parser->lookup_symbol(parser, "hidden_s", &symbol));
+        NK_Parse_Free(&parser);
+    }
+
+    check_symbolize_many(dir, "many_be.so");
+}
+
+/**
+ * 扩展编号：段数与段表字符串表索引超出 16 位，由 0 号段解析；\n
+ * 段索引超过 0xff00 的符号经 SHT_SYMTAB_SHNDX 得到实际段索引。\n
+ * @ref shnum、@ref shstrndx 为小端夹具 0 号段记录的实际值。
+ */
+static NK_Void
+check_extended_fixture(const NK_Char *dir, const NK_Char *name, NK_UInt64 shnum, NK_UInt32 shstrndx) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfCursor cursor;
+    NK_ElfSectionInfo section;
+    NK_ElfSymbol symbol;
+    NK_UInt64 Cnt = 0;
+    NK_Int Last = -1;
+
+    parser = open_fixture(dir, name, NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(0 == parser->sections(parser, &cursor));
+    while (0 == parser->next_section(parser, &cursor, &section)) {
+        Cnt++;
+    }
+    CHECK(shnum == Cnt);
+
+    /// 段名取自扩展编号得到的段表字符串表。
+    CHECK((NK_Int)shstrndx == parser->find_section(parser, ".shstrtab"));
+    CHECK(parser->find_section(parser, ".s65299") > 0xff00);
+
+    Last = parser->find_section(parser, ".last");
+    CHECK(Last > 0xff00);
+    CHECK(find_type(parser, SHT_SYMTAB_SHNDX) > 0xff00);
+
+    CHECK(0 == parser->lookup_symbol(parser, "last_sym", &symbol));
+    CHECK((NK_UInt32)Last == symbol.Shndx);
+    CHECK(STT_OBJECT == symbol.Type && 1 == symbol.Size);
+
+    NK_Parse_Free(&parser);
+}
+
+static NK_Void
+check_extended(const NK_Char *dir) {
+
+    NK_PByte Data = NK_Nil;
+    NK_Size64 Size = 0;
+    const Elf64_Ehdr *Ehdr = NK_Nil;
+    const Elf64_Shdr *Zero = NK_Nil;
+
+    /// 确认夹具的 ELF 头使用了转义值。
+    Data = load_fixture(dir, "sections.o", &Size);
+    if (NK_Nil == Data)
+        return;
+
+    Ehdr = (const Elf64_Ehdr *)Data;
+    CHECK(Size >= sizeof(Elf64_Ehdr) && ELFCLASS64 == Ehdr->e_ident[EI_CLASS]);
+    CHECK(0 == Ehdr->e_shnum && SHN_XINDEX == Ehdr->e_shstrndx);
+    CHECK(Ehdr->e_shoff + sizeof(Elf64_Shdr) <= Size);
+
+    if (Ehdr->e_shoff + sizeof(Elf64_Shdr) <= Size) {
+        Zero = (const Elf64_Shdr *)(Data + Ehdr->e_shoff);
+        CHECK(Zero->sh_size > 0xff00 && Zero->sh_link > 0xff00);
+        check_extended_fixture(dir, "sections.o", Zero->sh_size, Zero->sh_link);
+        check_extended_fixture(dir, "sections_be.o", Zero->sh_size, Zero->sh_link);
+    }
+
+    free(Data);
+}
+
+/**
+ * 段 @ref name 的内容视图与夹具文件 @ref file 中对应的字节相同，按索引与按名得到同一视图。
+ */
+static NK_Void
+check_span_bytes(NK_Parser *parser, const NK_Byte *file, NK_Size64 size, const NK_Char *name) {
+
+    NK_ElfSectionInfo section;
+    NK_ElfSpan span, named;
+    NK_Int Index = parser->find_section(parser, (NK_PChar)name);
+
+    CHECK(Index > 0 && 0 == section_info(parser, Index, &section));
+    CHECK(0 == parser->span(parser, Index, &span));
+    CHECK(0 == parser->span_by_name(parser, (NK_PChar)name, &named));
+    CHECK(span.Data == named.Data && span.Size == named.Size);
+
+    CHECK(section.Size > 0 && section.Size == span.Size && section.Offset + section.Size <= size);
+    if (NK_Nil != span.Data && section.Size == span.Size && section.Offset + section.Size <= size) {
+        CHECK(0 == memcmp(span.Data, file + section.Offset, (size_t)span.Size));
+    }
+}
+
+/**
+ * 段内容视图：已知段的内容与文件相同，NOBITS 段没有内容，不存在的段与无效索引失败。
+ */
+static NK_Void
+check_spans(NK_Parser *parser, const NK_Byte *file, NK_Size64 size) {
+
+    NK_ElfCursor cursor;
+    NK_ElfSpan span;
+
+    check_span_bytes(parser, file, size, ".dynstr");
+    check_span_bytes(parser, file, size, ".shstrtab");
+    check_span_bytes(parser, file, size, ".text");
+
+    CHECK(find_type(parser, SHT_NOBITS) > 0);
+    CHECK(0 == parser->span(parser, find_type(parser, SHT_NOBITS), &span));
+    CHECK(NK_Nil == span.Data && 0 == span.Size);
+    CHECK(0 == parser->span_by_name(parser, ".bss", &span));
+    CHECK(NK_Nil == span.Data && 0 == span.Size);
+
+    CHECK(-1 == parser->span_by_name(parser, ".no_such_section", &span));
+    CHECK(0 == parser->sections(parser, &cursor));
+    CHECK(-1 == parser->span(parser, -1, &span));
+    CHECK(-1 == parser->span(parser, (NK_Int)cursor.Count, &span));
+}
+
+static NK_Void
+check_span(const NK_Char *dir) {
+
+    static const NK_UInt32 Flags[] = {NK_PARSE_DEFAULT, NK_PARSE_LAZY};
+    NK_Parser *parser = NK_Nil;
+    NK_PByte Data = NK_Nil;
+    NK_Size64 Size = 0;
+    NK_Size i;
+
+    Data = load_fixture(dir, "fixture_gnu.so", &Size);
+    if (NK_Nil == Data)
+        return;
+
+    /// 映射与延迟加载的源。
+    for (i = 0; i < sizeof(Flags) / sizeof(Flags[0]); i++) {
+        parser = open_fixture(dir, "fixture_gnu.so", Flags[i]);
+        if (NK_Nil != parser) {
+            check_spans(parser, Data, Size);
+            NK_Parse_Free(&parser);
+        }
+    }
+
+    free(Data);
+}
+
+/**
+ * 按名查找段：每个段名都能找到同名的段，同名段返回索引最小的一个，不存在的名字失败。
+ */
+static NK_Void
+check_find_fixture(const NK_Char *dir, const NK_Char *name, NK_Int dups) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfCursor cursor;
+    NK_ElfSectionInfo section, found;
+    NK_ElfSpan span;
+    NK_Int Index = -1, First = -1, Cnt = 0;
+
+    parser = open_fixture(dir, name, NK_PARSE_DEFAULT);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(0 == parser->sections(parser, &cursor));
+    while (0 == parser->next_section(parser, &cursor, &section)) {
+        if (0 == section.Index || '\0' == section.Name[0])
+            continue;
+
+        Index = parser->find_section(parser, (NK_PChar)section.Name);
+        CHECK(Index >= 0 && Index <= (NK_Int)section.Index);
+        CHECK(0 == section_info(parser, Index, &found) && 0 == strcmp(found.Name, section.Name));
+
+        if (0 == strcmp(".dup", section.Name)) {
+            if (First < 0)
+                First = (NK_Int)section.Index;
+            Cnt++;
+        }
+    }
+
+    /// 同名段取最前的一个，内容为 1。
+    CHECK(dups == Cnt);
+    if (dups > 0) {
+        CHECK(First == parser->find_section(parser, ".dup"));
+        CHECK(0 == parser->span_by_name(parser, ".dup", &span));
+        CHECK(1 == span.Size && NK_Nil != span.Data && 1 == *(const NK_Byte *)span.Data);
+    }
+
+    CHECK(-1 == parser->find_section(parser, ".no_such_section"));
+    CHECK(-1 == parser->find_section(parser, ".dup."));
+    CHECK(-1 == parser->find_section(parser, ".du"));
+    CHECK(-1 == parser->find_section(parser, ".s65300"));
+    CHECK(-1 == parser->find_section(parser, NK_Nil));
+
+    NK_Parse_Free(&parser);
+}
+
+static NK_Void
+check_find_section(const NK_Char *dir) {
+
+    check_find_fixture(dir, "fixture_gnu.so", 0);
+    check_find_fixture(dir, "sections.o", 3);
+    check_find_fixture(dir, "sections_be.o", 3);
+}
+
+/**
+ * 符号表游标：逐项与文件中的原始符号比较，个数为 sh_size / sh_entsize，索引连续。
+ */
+static NK_Void
+check_symbol_cursor(NK_Parser *parser, const NK_Byte *file, NK_Size64 size, const Elf64_Shdr *shdr, NK_Int index) {
+
+    NK_ElfCursor cursor;
+    NK_ElfSymbol symbol;
+    const Elf64_Shdr *Strtab = shdr + shdr[index].sh_link;
+    const Elf64_Sym *Sym = (const Elf64_Sym *)(file + shdr[index].sh_offset);
+    NK_Size64 Cnt = 0, Total = shdr[index].sh_size / shdr[index].sh_entsize;
+
+    CHECK(shdr[index].sh_offset + shdr[index].sh_size <= size && Strtab->sh_offset + Strtab->sh_size <= size);
+    CHECK(0 == parser->symbols(parser, index, &cursor));
+
+    while (0 == parser->next_symbol(parser, &cursor, &symbol)) {
+        if (Cnt >= Total)
+            break;
+
+        CHECK(Cnt == symbol.Index);
+        CHECK(Sym[Cnt].st_value == symbol.Value && Sym[Cnt].st_size == symbol.Size);
+        CHECK(ELF64_ST_TYPE(Sym[Cnt].st_info) == symbol.Type && ELF64_ST_BIND(Sym[Cnt].st_info) == symbol.Bind);
+        CHECK(0 == strcmp((const NK_Char *)file + Strtab->sh_offset + Sym[Cnt].st_name, symbol.Name));
+        Cnt++;
+    }
+
+    CHECK(Total > 0 && Total == Cnt);
+
+    /// 遍历结束后保持结束状态。
+    CHECK(-1 == parser->next_symbol(parser, &cursor, &symbol));
+}
+
+/**
+ * 段与符号表游标：段的个数与顺序与 e_shnum 及文件中的段表一致，每个符号表逐项一致。
+ */
+static NK_Void
+check_cursor_fixture(const NK_Char *dir, const NK_Char *name, NK_Boolean stripped) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_ElfCursor cursor;
+    NK_ElfSectionInfo section;
+    NK_ElfSymbol symbol;
+    NK_PByte Data = NK_Nil;
+    NK_Size64 Size = 0;
+    const Elf64_Ehdr *Ehdr = NK_Nil;
+    const Elf64_Shdr *Shdr = NK_Nil;
+    const NK_Char *Names = NK_Nil;
+    NK_Int Cnt = 0, Tables = 0, Symtab = -1, Text = -1;
+    NK_Int i;
+
+    Data = load_fixture(dir, name, &Size);
+    if (NK_Nil == Data)
+        return;
+
+    Ehdr = (const Elf64_Ehdr *)Data;
+    CHECK(ELFCLASS64 == Ehdr->e_ident[EI_CLASS] && Ehdr->e_shnum > 0);
+    CHECK(Ehdr->e_shoff + (NK_Size64)Ehdr->e_shnum * sizeof(Elf64_Shdr) <= Size);
+    if (ELFCLASS64 != Ehdr->e_ident[EI_CLASS] || Ehdr->e_shoff + (NK_Size64)Ehdr->e_shnum * sizeof(Elf64_Shdr) > Size) {
+        free(Data);
+        return;
+    }
+
+    Shdr = (const Elf64_Shdr *)(Data + Ehdr->e_shoff);
+    Names = (const NK_Char *)Data + Shdr[Ehdr->e_shstrndx].sh_offset;
+
+    parser = open_fixture(dir, name, NK_PARSE_DEFAULT);
+    if (NK_Nil == parser) {
+        free(Data);
+        return;
+    }
+
+    /// 段按文件中的顺序逐个给出。
+    CHECK(0 == parser->sections(parser, &cursor));
+    while (0 == parser->next_section(parser, &cursor, &section)) {
+        if (Cnt >= Ehdr->e_shnum)
+            break;
+
+        CHECK(Cnt == section.Index);
+        CHECK(0 == strcmp(Names + Shdr[Cnt].sh_name, section.Name));
+        CHECK(Shdr[Cnt].sh_type == section.Type && Shdr[Cnt].sh_offset == section.Offset);
+        CHECK(Shdr[Cnt].sh_size == section.Size && Shdr[Cnt].sh_link == section.Link);
+        Cnt++;
+    }
+    CHECK(Ehdr->e_shnum == Cnt);
+    CHECK(-1 == parser->next_section(parser, &cursor, &section));
+
+    for (i = 0; i < Ehdr->e_shnum; i++) {
+        if (SHT_SYMTAB == Shdr[i].sh_type)
+            Symtab = i;
+        if (0 == strcmp(".text", Names + Shdr[i].sh_name))
+            Text = i;
+        if (SHT_SYMTAB == Shdr[i].sh_type || SHT_DYNSYM == Shdr[i].sh_type) {
+            check_symbol_cursor(parser, Data, Size, Shdr, i);
+            Tables++;
+        }
+    }
+
+    /// 剥离后只剩 .dynsym。
+    CHECK(stripped ? (1 == Tables && Symtab < 0) : (2 == Tables && Symtab > 0));
+    CHECK(Symtab == find_type(parser, SHT_SYMTAB));
+
+    /// 不是符号表的段与无效索引不能遍历。
+    CHECK(Text > 0 && -1 == parser->symbols(parser, Text, &cursor));
+    CHECK(-1 == parser->symbols(parser, -1, &cursor));
+    CHECK(-1 == parser->symbols(parser, Ehdr->e_shnum, &cursor));
+    CHECK(-1 == parser->next_symbol(parser, NK_Nil, &symbol));
+
+    NK_Parse_Free(&parser);
+    free(Data);
+}
+
+static NK_Void
+check_cursors(const NK_Char *dir) {
+
+    check_cursor_fixture(dir, "fixture_gnu.so", NK_False);
+    check_cursor_fixture(dir, "fixture_sysv.so", NK_False);
+    check_cursor_fixture(dir, "fixture_strip.so", NK_True);
+}
+
+/// segments 输出中的程序段类型与所含段名，段名以空格分隔并以空格结尾。
+typedef struct Mapping {
+
+    NK_Int Count;
+    NK_Char Types[16][32];
+    NK_Char Names[16][512];
+
+} Mapping;
+
+/**
+ * 调用 segments 并从标准输出中取回程序头表与段到程序段的映射。
+ */
+static NK_Int
+capture_segments(NK_Parser *parser, Mapping *map) {
+
+    NK_Char Line[1024];
+    NK_UInt32 Nr = 0;
+    NK_Int Saved = -1, Ret = -1, Mapped = 0;
+    FILE *fp = tmpfile();
+
+    memset(map, 0, sizeof(Mapping));
+    if (NK_Nil == fp)
+        return -1;
+
+    fflush(stdout);
+    Saved = dup(STDOUT_FILENO);
+    if (Saved >= 0 && dup2(fileno(fp), STDOUT_FILENO) >= 0) {
+        Ret = parser->segments(parser);
+        fflush(stdout);
+        dup2(Saved, STDOUT_FILENO);
+    }
+    if (Saved >= 0)
+        close(Saved);
+
+    rewind(fp);
+    while (NK_Nil != fgets(Line, sizeof(Line), fp)) {
+        if (NK_Nil != strstr(Line, "Section to Segment mapping")) {
+            Mapped = 1;
+        } else if (!Mapped && 1 == sscanf(Line, "  [%u]", &Nr) && Nr < 16) {
+            sscanf(strchr(Line, ']') + 1, "%31s", map->Types[Nr]);
+            map->Count = Nr + 1 > (NK_UInt32)map->Count ? (NK_Int)Nr + 1 : map->Count;
+        } else if (Mapped && 1 == sscanf(Line, "   %u", &Nr) && Nr < 16 && strlen(Line) > 10) {
+            snprintf(map->Names[Nr], sizeof(map->Names[Nr]), " %s", Line + 10);
+            map->Names[Nr][strcspn(map->Names[Nr], "\n")] = '\0';
+        }
+    }
+    fclose(fp);
+
+    return Ret;
+}
+
+/**
+ * 段 @ref name 所在的 @ref type 类型程序段个数，@ref type 为 NK_Nil 时不限类型。
+ */
+static NK_Int
+mapped(const Mapping *map, const NK_Char *type, const NK_Char *name) {
+
+    NK_Char Token[64];
+    NK_Int i, Cnt = 0;
+
+    snprintf(Token, sizeof(Token), " %s ", name);
+    for (i = 0; i < map->Count; i++) {
+        if ((NK_Nil == type || 0 == strcmp(type, map->Types[i])) && NK_Nil != strstr(map->Names[i], Token))
+            Cnt++;
+    }
+
+    return Cnt;
+}
+
+/**
+ * 段到程序段的映射：LOAD、GNU_RELRO、NOTE、TLS 的成员，\n
+ * 以及 NOBITS 的 .bss 与 TLS 的 .tdata、.tbss 按严格规则的归属。
+ */
+static NK_Void
+check_segment_fixture(const NK_Char *dir, const NK_Char *name, NK_UInt32 flags) {
+
+    NK_Parser *parser = NK_Nil;
+    static Mapping Map;
+    NK_Int i;
+
+    parser = open_fixture(dir, name, flags);
+    if (NK_Nil == parser)
+        return;
+
+    CHECK(0 == capture_segments(parser, &Map));
+    CHECK(Map.Count > 0);
+
+    /// 每个占内存的段恰好落在一个 LOAD 中，.tbss 除外。
+    CHECK(1 == mapped(&Map, "LOAD", ".dynsym") && 1 == mapped(&Map, "LOAD", ".text"));
+    CHECK(1 == mapped(&Map, "LOAD", ".data") && 1 == mapped(&Map, "LOAD", ".bss"));
+    CHECK(1 == mapped(&Map, "LOAD", ".tdata") && 0 == mapped(&Map, "LOAD", ".tbss"));
+
+    /// .bss 没有文件内容，按地址归入与 .data 相同的可写 LOAD。
+    for (i = 0; i < Map.Count; i++) {
+        if (0 == strcmp("LOAD", Map.Types[i]) && NK_Nil != strstr(Map.Names[i], " .bss ")) {
+            CHECK(NK_Nil != strstr(Map.Names[i], " .data "));
+            CHECK(NK_Nil == strstr(Map.Names[i], " .text "));
+        }
+    }
+
+    /// GNU_RELRO 包含 .tdata 与 .dynamic、.got，不含 .tbss、.data 与 .bss。
+    CHECK(1 == mapped(&Map, "GNU_RELRO", ".tdata") && 1 == mapped(&Map, "GNU_RELRO", ".dynamic"));
+    CHECK(1 == mapped(&Map, "GNU_RELRO", ".got"));
+    CHECK(0 == mapped(&Map, "GNU_RELRO", ".tbss") && 0 == mapped(&Map, "GNU_RELRO", ".data"));
+    CHECK(0 == mapped(&Map, "GNU_RELRO", ".bss"));
+
+    /// NOTE 只含注释段。
+    CHECK(1 == mapped(&Map, "NOTE", ".note.gnu.build-id"));
+    CHECK(0 == mapped(&Map, "NOTE", ".dynsym") && 0 == mapped(&Map, "NOTE", ".text"));
+
+    /// .tbss 只属于 TLS，非 TLS 段不属于 TLS。
+    CHECK(1 == mapped(&Map, "TLS", ".tdata") && 1 == mapped(&Map, "TLS", ".tbss"));
+    CHECK(1 == mapped(&Map, NK_Nil, ".tbss"));
+    CHECK(0 == mapped(&Map, "TLS", ".bss") && 0 == mapped(&Map, "TLS", ".data"));
+
+    /// 不占内存的段不属于任何程序段。
+    CHECK(0 == mapped(&Map, NK_Nil, ".comment") && 0 == mapped(&Map, NK_Nil, ".shstrtab"));
+    CHECK(0 == mapped(&Map, NK_Nil, ".symtab") && 0 == mapped(&Map, NK_Nil, ".strtab"));
+
+    NK_Parse_Free(&parser);
+}
+
+static NK_Void
+check_segments(const NK_Char *dir) {
+
+    check_segment_fixture(dir, "fixture_gnu.so", NK_PARSE_DEFAULT);
+    check_segment_fixture(dir, "fixture_gnu.so", NK_PARSE_LAZY);
+    check_segment_fixture(dir, "fixture_be.so", NK_PARSE_DEFAULT);
+}
+
+/**
+ * 调用者内存上的解析：查找与按地址查找同文件源一致，段内容直接指向调用者的缓冲区，\n
+ * own 为假时销毁解析器不释放也不改写缓冲区，为真时由解析器释放。
+ */
+static NK_Void
+check_memory(const NK_Char *dir) {
+
+    NK_Parser *parser = NK_Nil;
+    NK_PByte Data = NK_Nil, Copy = NK_Nil;
+    NK_Size64 Size = 0;
+    NK_ElfSpan span;
+
+    Data = load_fixture(dir, "fixture_gnu.so", &Size);
+    if (NK_Nil == Data)
+        return;
+
+    Copy = malloc((size_t)Size);
+    CHECK(NK_Nil != Copy);
+    if (NK_Nil == Copy) {
+        free(Data);
+        return;
+    }
+    memcpy(Copy, Data, (size_t)Size);
+
+    CHECK(NK_Nil == NK_Parse_CreateFromMemory(NK_Nil, Size, NK_False));
+    CHECK(NK_Nil == NK_Parse_CreateFromMemory(Data, 0, NK_False));
+
+    parser = NK_Parse_CreateFromMemory(Data, Size, NK_False);
+    CHECK(NK_Nil != parser && 0 == parser->parse(parser));
+    if (NK_Nil != parser) {
+        check_names(parser);
+        check_addresses(parser, NK_True);
+        check_spans(parser, Copy, Size);
+
+        /// 不拷贝：段内容位于调用者的缓冲区内。
+        CHECK(0 == parser->span_by_name(parser, ".dynstr", &span));
+        CHECK((const NK_Byte *)span.Data > Data && (const NK_Byte *)span.Data + span.Size <= Data + Size);
+        NK_Parse_Free(&parser);
+    }
+    CHECK(NK_Nil == parser);
+
+    /// 缓冲区仍属于调用者，内容不变，可再次解析。
+    CHECK(0 == memcmp(Data, Copy, (size_t)Size));
+    parser = NK_Parse_CreateFromMemory(Data, Size, NK_False);
+    CHECK(NK_Nil != parser && 0 == parser->parse(parser));
+    if (NK_Nil != parser) {
+        check_names(parser);
+        NK_Parse_Free(&parser);
+    }
+    free(Data);
+
+    /// 所有权转移后由解析器释放 Copy。
+    parser = NK_Parse_CreateFromMemory(Copy, Size, NK_True);
+    CHECK(NK_Nil != parser && 0 == parser->parse(parser));
+    if (NK_Nil != parser) {
+        check_names(parser);
+        NK_Parse_Free(&parser);
+    } else {
+        free(Copy);
+    }
+}
+
+/**
+ * 批量解析一组夹具：成功的个数、每一项的成败与结果分别检查，\n
+ * 不存在的文件与不是 ELF 的文件各自失败，不影响其余各项。
+ */
+static NK_Void
+check_batch_flags(const NK_Char *dir, NK_UInt32 flags) {
+
+    static const struct {
+        const NK_Char *Name;
+        NK_Boolean Elf;
+    } Expect[] = {
+        {"fixture_gnu.so",      NK_True},
+        {"no_such_fixture.so",  NK_False},
+        {"fixture_sysv.so",     NK_True},
+        {"fixture.c",           NK_False},
+        {"fixture_strip.so",    NK_True},
+        {"fixture_be.so",       NK_True},
+        {"sections.o",          NK_True},
+    };
+    enum { COUNT = sizeof(Expect) / sizeof(Expect[0]) };
+
+    NK_Char Paths[COUNT][1024];
+    NK_PChar Elfs[COUNT];
+    NK_Parser *parsers[COUNT];
+    NK_ElfSymbol symbol;
+    NK_PByte Data = NK_Nil;
+    NK_Size64 Size = 0;
+    NK_Int i, Valid = 0;
+
+    for (i = 0; i < COUNT; i++) {
+        snprintf(Paths[i], sizeof(Paths[i]), "%s/%s", dir, Expect[i].Name);
+        Elfs[i] = Paths[i];
+        /// 预置非空值，失败的项须被置为 NK_Nil。
+        parsers[i] = (NK_Parser *)&Paths[i];
+        Valid += Expect[i].Elf ? 1 : 0;
+    }
+
+    Fixture = "batch";
+    CHECK(Valid == NK_Parse_CreateBatch(Elfs, COUNT, flags, parsers));
+
+    for (i = 0; i < COUNT; i++) {
+        Fixture = Expect[i].Name;
+        CHECK(Expect[i].Elf == (NK_Nil != parsers[i]));
+    }
+
+    /// 各项的结果与单独解析一致，段内容按需读取。
+    for (i = 0; i < COUNT; i++) {
+        if (NK_Nil == parsers[i])
+            continue;
+
+        Fixture = Expect[i].Name;
+        if (0 == strcmp("sections.o", Expect[i].Name)) {
+            CHECK(0 == parsers[i]->lookup_symbol(parsers[i], "last_sym", &symbol));
+            CHECK(symbol.Shndx > 0xff00 && (NK_Int)symbol.Shndx == parsers[i]->find_section(parsers[i], ".last"));
+        } else {
+            check_names(parsers[i]);
+            CHECK((0 == strcmp("fixture_strip.so", Expect[i].Name)) == (-1 == find_type(parsers[i], SHT_SYMTAB)));
+        }
+    }
+
+    if (NK_Nil != parsers[0] && NK_Nil != (Data = load_fixture(dir, Expect[0].Name, &Size))) {
+        check_spans(parsers[0], Data, Size);
+        free(Data);
+    }
+
+    for (i = 0; i < COUNT; i++) {
+        if (NK_Nil != parsers[i])
+            NK_Parse_Free(&parsers[i]);
+    }
+
+    /// 空的批量与参数错误。
+    Fixture = "batch";
+    CHECK(0 == NK_Parse_CreateBatch(Elfs, 0, flags, parsers));
+    CHECK(-1 == NK_Parse_CreateBatch(NK_Nil, COUNT, flags, parsers));
+    CHECK(-1 == NK_Parse_CreateBatch(Elfs, COUNT, flags, NK_Nil));
+}
+
+/**
+ * 批量解析，不带缓存以及带缓存的写入与命中各一轮。\n
+ * 默认构建走 io_uring，定义 NK_NO_IO_URING 的构建（make check 中的 check_threads）走线程池。
+ */
+static NK_Void
+check_batch(const NK_Char *dir) {
+
+    NK_Char Cache[1024];
+
+    check_batch_flags(dir, NK_PARSE_DEFAULT);
+
+    snprintf(Cache, sizeof(Cache), "%s/cache", dir);
+    CHECK(0 == NK_Parse_SetCacheDir(Cache));
+    check_batch_flags(dir, NK_PARSE_CACHE);
+    check_batch_flags(dir, NK_PARSE_CACHE);
+    NK_Parse_SetCacheDir(NK_Nil);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <fixture dir> [batch]\n", argv[0]);
+        return -1;
+    }
+
+    /// 只检查批量解析，用于另一种读取方式的构建。
+    if (argc > 2 && 0 == strcmp("batch", argv[2])) {
+        check_batch(argv[1]);
+        goto _exit;
+    }
+
+    check_gnu_hash(argv[1]);
+    check_sysv_hash(argv[1]);
+    check_statics(argv[1]);
+    check_bad_gnu_hash(argv[1]);
+    check_nested(argv[1]);
+    check_symbolize_small(argv[1]);
+    check_symbolize_many(argv[1], "many.so");
+    check_stream(argv[1]);
+    check_cache(argv[1]);
+    check_big_endian(argv[1]);
+    check_extended(argv[1]);
+    check_span(argv[1]);
+    check_find_section(argv[1]);
+    check_cursors(argv[1]);
+    check_segments(argv[1]);
+    check_memory(argv[1]);
+    check_batch(argv[1]);
+
+_exit:
+    if (Failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", Failures);
+        return 1;
+    }
+
+    printf("all checks passed\n");
+    return 0;
+}
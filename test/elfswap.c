@@ -0,0 +1,185 @@
+/**
+ * make check 的夹具工具：把小端 elf 改写为等价的大端 elf。\n
+ * 用法：elfswap <输入> <输出>。\n
+ * 只转换解析器解码的结构：ELF 头、程序头表、段表、符号表、散列表与扩展段索引表，\n
+ * 其余段内容（代码、.dynamic、重定位等）保持原样。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <elf.h>
+
+/// 各结构的字段宽度，以 0 结尾。
+static const int Ehdr64[] = {2, 2, 4, 8, 8, 8, 4, 2, 2, 2, 2, 2, 2, 0};
+static const int Ehdr32[] = {2, 2, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 0};
+static const int Phdr64[] = {4, 4, 8, 8, 8, 8, 8, 8, 0};
+static const int Phdr32[] = {4, 4, 4, 4, 4, 4, 4, 4, 0};
+static const int Shdr64[] = {4, 4, 8, 8, 8, 8, 4, 4, 8, 8, 0};
+static const int Shdr32[] = {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 0};
+static const int Sym64[] = {4, 1, 1, 2, 8, 8, 0};
+static const int Sym32[] = {4, 4, 4, 1, 1, 2, 0};
+
+static unsigned char *Data = NULL;
+static size_t Size = 0;
+
+/**
+ * 读取 @ref off 处 @ref width 字节的小端整数。
+ */
+static unsigned long long
+load(size_t off, int width) {
+
+    unsigned long long v = 0;
+    int i;
+
+    for (i = width - 1; i >= 0; i--) {
+        v = (v << 8) | Data[off + i];
+    }
+
+    return v;
+}
+
+/**
+ * 按字段宽度原地翻转一个结构，返回结构长度；越界时退出。
+ */
+static size_t
+swap(size_t off, const int *layout) {
+
+    size_t pos = off;
+    int i, k;
+
+    for (i = 0; 0 != layout[i]; i++) {
+        if (pos + layout[i] > Size) {
+            fprintf(stderr, "elfswap: structure at 0x%zx out of range\n", off);
+            exit(1);
+        }
+        for (k = 0; k < layout[i] / 2; k++) {
+            unsigned char t = Data[pos + k];
+            Data[pos + k] = Data[pos + layout[i] - 1 - k];
+            Data[pos + layout[i] - 1 - k] = t;
+        }
+        pos += layout[i];
+    }
+
+    return pos - off;
+}
+
+/**
+ * 翻转 [off, off + size) 内连续的 @ref width 字节整数。
+ */
+static void
+swap_words(size_t off, size_t size, int width) {
+
+    const int layout[] = {width, 0};
+    size_t i;
+
+    for (i = 0; i + width <= size; i += width) {
+        swap(off + i, layout);
+    }
+}
+
+int main(int argc, char **argv) {
+
+    FILE *fp = NULL;
+    long len = -1;
+    int wide = 0;
+    unsigned long long phoff, shoff, shnum, i;
+    unsigned long long phnum, phent, shent;
+    const int *layout = NULL;
+
+    if (3 != argc) {
+        fprintf(stderr, "usage: elfswap <input> <output>\n");
+        return 1;
+    }
+
+    fp = fopen(argv[1], "rb");
+    if (NULL == fp || 0 != fseek(fp, 0, SEEK_END) || (len = ftell(fp)) < 0 || 0 != fseek(fp, 0, SEEK_SET)) {
+        fprintf(stderr, "elfswap: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    Size = (size_t)len;
+    Data = malloc(Size ? Size : 1);
+    if (NULL == Data || Size != fread(Data, 1, Size, fp)) {
+        fprintf(stderr, "elfswap: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(fp);
+
+    if (Size < EI_NIDENT || 0 != memcmp(Data, ELFMAG, SELFMAG) || ELFDATA2LSB != Data[EI_DATA]) {
+        fprintf(stderr, "elfswap: %s is not a little-endian elf\n", argv[1]);
+        return 1;
+    }
+    wide = (ELFCLASS64 == Data[EI_CLASS]);
+
+    /// 先按小端取出表的位置，再翻转。
+    if (wide) {
+        phoff = load(32, 8); shoff = load(40, 8);
+        phent = load(54, 2); phnum = load(56, 2); shent = load(58, 2); shnum = load(60, 2);
+    } else {
+        phoff = load(28, 4); shoff = load(32, 4);
+        phent = load(42, 2); phnum = load(44, 2); shent = load(46, 2); shnum = load(48, 2);
+    }
+    swap(EI_NIDENT, wide ? Ehdr64 : Ehdr32);
+    Data[EI_DATA] = ELFDATA2MSB;
+
+    for (i = 0; i < phnum; i++) {
+        swap(phoff + i * phent, wide ? Phdr64 : Phdr32);
+    }
+
+    /// 段数超过 SHN_LORESERVE 时记录在 0 号段的 sh_size。
+    if (0 == shnum && 0 != shoff) {
+        shnum = wide ? load(shoff + 32, 8) : load(shoff + 20, 4);
+    }
+
+    for (i = 0; i < shnum; i++) {
+
+        size_t sh = shoff + i * shent;
+        unsigned long long type, offset, size, pos;
+
+        type = load(sh + 4, 4);
+        offset = wide ? load(sh + 24, 8) : load(sh + 16, 4);
+        size = wide ? load(sh + 32, 8) : load(sh + 20, 4);
+        swap(sh, wide ? Shdr64 : Shdr32);
+
+        if (SHT_NOBITS == type || offset > Size || size > Size - offset)
+            continue;
+
+        switch (type) {
+        case SHT_SYMTAB:
+        case SHT_DYNSYM:
+            layout = wide ? Sym64 : Sym32;
+            for (pos = 0; pos + (wide ? 24 : 16) <= size; pos += (wide ? 24 : 16)) {
+                swap(offset + pos, layout);
+            }
+            break;
+        case SHT_GNU_HASH:
+            /// nbuckets、symoffset、bloom 字数、bloom 移位之后是地址宽度的 bloom 字，其余为 4 字节。
+            if (size >= 16) {
+                unsigned long long words = load(offset + 8, 4);
+                unsigned long long bloom = words * (wide ? 8 : 4);
+                swap_words(offset, 16, 4);
+                if (bloom <= size - 16) {
+                    swap_words(offset + 16, bloom, wide ? 8 : 4);
+                    swap_words(offset + 16 + bloom, size - 16 - bloom, 4);
+                }
+            }
+            break;
+        case SHT_HASH:
+        case SHT_SYMTAB_SHNDX:
+            swap_words(offset, size, 4);
+            break;
+        default:
+            break;
+        }
+    }
+
+    fp = fopen(argv[2], "wb");
+    if (NULL == fp || Size != fwrite(Data, 1, Size, fp) || 0 != fclose(fp)) {
+        fprintf(stderr, "elfswap: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    free(Data);
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * make check 的测试夹具，编译为共享库后由 check 解析，结果与下列已知的符号比较。
+ */
+
+int alpha(void) { return 1; }
+
+int beta = 2;
+
+int gamma_v[4] = {3};
+
+/// 局部函数只在 .symtab 中。
+__attribute__((noinline, used)) static int
+hidden_s(int x) { return x + 1; }
+
+int delta(int x) { return hidden_s(x); }
+
+/// 线程局部变量，分别落在 .tdata 与 .tbss 中。
+__thread int tls_d = 5;
+
+__thread int tls_b;
+
+/**
+ * 嵌套的符号：outer 长 0x100，inner 位于其中 [0x10, 0x20)，零长度的局部标号 label 位于 0x60。
+ */
+__asm__(
+    "   .pushsection .text\n"
+    "   .globl  outer\n"
+    "   .type   outer, %function\n"
+    "outer:\n"
+    "   .skip   0x10\n"
+    "   .globl  inner\n"
+    "   .type   inner, %function\n"
+    "inner:\n"
+    "   .skip   0x10\n"
+    "   .size   inner, 0x10\n"
+    "   .skip   0x40\n"
+    "   .type   label, %function\n"
+    "label:\n"
+    "   .skip   0xa0\n"
+    "   .size   outer, . - outer\n"
+    "   .popsection\n");
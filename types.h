@@ -30,10 +30,21 @@
  */
 #if defined(_WIN32)
 #  define NK_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#  define NK_API extern __attribute__((visibility("default")))
 #else
 #  define NK_API extern
 #endif
 
+/**
+ * Library-Internal Symbol, Not Exported From The Shared Library.
+ */
+#if defined(__GNUC__) && !defined(_WIN32)
+#  define NK_LOCAL extern __attribute__((visibility("hidden")))
+#else
+#  define NK_LOCAL extern
+#endif
+
 
 #ifndef __NK_TYPES_H__
 #define __NK_TYPES_H__
@@ -1,11 +1,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#if defined(__linux__) && !defined(NK_NO_IO_URING)
+#  include <sys/syscall.h>
+#  include <linux/io_uring.h>
+#  define NK_HAVE_IO_URING (1)
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(NK_NO_SIMD)
+#  include <immintrin.h>
+#  define NK_HAVE_SHUFFLE (1)
+#endif
 
 #include <assert.h>
+#include <utils.h>
+
+/**
+ * 单次读写的最大长度，Linux 单次 read/pread 最多传输约 2 GiB。
+ */
+#define NK_IO_CHUNK (1 << 30)
 
-NK_Int  NK_GetFileSize(NK_PChar pathFile)
+NK_Size64  NK_GetFileSize(NK_PChar pathFile)
 {
 #if defined(_WIN32)
     #error "error : no implemented!"
@@ -16,25 +39,30 @@ NK_Int  NK_GetFileSize(NK_PChar pathFile)
     if(stat(pathFile, &stStatBuf) < 0){
         return 0;
     }
-    return (NK_Int)stStatBuf.st_size;
+    return (NK_Size64)stStatBuf.st_size;
 #endif
 }
 
-NK_Int NK_ReadFile2Buffer(const NK_PChar file, NK_PChar *data)
+NK_SSize64 NK_ReadFile2Buffer(const NK_PChar file, NK_PChar *data)
 {
     NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
     FILE *fp = NK_Nil;
     char *buf = NK_Nil;
-    NK_Int filesize = (int)NK_GetFileSize(file);
-    if (filesize >  0) {
+    NK_Size64 filesize = NK_GetFileSize(file);
+    // the whole image must fit into one allocation of this address space
+    if (filesize > 0 && filesize < (NK_Size64)(size_t)-1 - 10) {
         char *ptr = NK_Nil;
-        int rdsize = 0;
+        NK_Size64 rdsize = 0;
         fp = fopen(file, "r");
         NK_EXPECT_RETURN_VAL( NK_Nil != fp, -1);
-        buf = (char *)malloc(filesize+10);
+        buf = (char *)malloc((size_t)filesize+10);
+        NK_EXPECT_JUMP(NK_Nil != buf, _fail_exit);
         ptr = buf;
+        // one front-to-back pass, let the kernel read ahead aggressively
+        NK_AdviseFile(fileno(fp), 0, 0, NK_ADVICE_SEQUENTIAL);
         for(;;) {
-            int ret = (int)fread(ptr, 1, filesize - rdsize, fp);
+            NK_Size64 chunk = filesize - rdsize;
+            size_t ret = fread(ptr, 1, (size_t)(chunk > NK_IO_CHUNK ? NK_IO_CHUNK : chunk), fp);
             if (ret > 0) {
                 rdsize += ret;
                 ptr += ret;
@@ -47,10 +75,12 @@ NK_Int NK_ReadFile2Buffer(const NK_PChar file, NK_PChar *data)
         //if (feof(fp) != 0) 
         if (rdsize == filesize)
         {
+            // the image now lives on the heap, the cached pages are not needed
+            NK_AdviseFile(fileno(fp), 0, 0, NK_ADVICE_DONTNEED);
             fclose(fp);
             buf[rdsize] = 0;
             *data = buf;
-            return rdsize;
+            return (NK_SSize64)rdsize;
         } else {
             goto _fail_exit;
         }
@@ -61,3 +91,723 @@ _fail_exit:
     if (fp) fclose(fp);
     return -1;
 }
+
+NK_SSize64 NK_MapFile2Buffer(const NK_PChar file, NK_PChar *data)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    struct stat stStatBuf;
+    void *map = MAP_FAILED;
+    int fd = -1;
+
+    // only regular files can be mapped, pipes and devices are left unopened
+    // so that they can still be consumed by a stream reader
+    if (stat(file, &stStatBuf) < 0 || !S_ISREG(stStatBuf.st_mode)) {
+        return -1;
+    }
+
+    fd = open(file, O_RDONLY);
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+
+    // images larger than the address space are left to the windowed pread path
+    if (fstat(fd, &stStatBuf) < 0 || !S_ISREG(stStatBuf.st_mode) || stStatBuf.st_size <= 0
+        || (NK_Size64)stStatBuf.st_size > (NK_Size64)(size_t)-1) {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NK_Nil, (size_t)stStatBuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping holds its own reference to the file
+    close(fd);
+    NK_EXPECT_RETURN_VAL(MAP_FAILED != map, -1);
+
+    *data = (NK_PChar)map;
+    return (NK_SSize64)stStatBuf.st_size;
+#endif
+}
+
+NK_Int NK_UnmapBuffer(NK_PChar data, NK_Size64 size)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+    NK_EXPECT_RETURN_VAL(size > 0, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    return munmap(data, (size_t)size);
+#endif
+}
+
+NK_Int NK_OpenFile(const NK_PChar file, NK_Size64 *size)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    struct stat stStatBuf;
+    int fd = -1;
+
+    // positional reads need a regular file, others are left unopened
+    if (stat(file, &stStatBuf) < 0 || !S_ISREG(stStatBuf.st_mode)) {
+        return -1;
+    }
+
+    fd = open(file, O_RDONLY);
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+
+    if (fstat(fd, &stStatBuf) < 0 || !S_ISREG(stStatBuf.st_mode)) {
+        close(fd);
+        return -1;
+    }
+
+    if (size) *size = (NK_Size64)stStatBuf.st_size;
+    return fd;
+#endif
+}
+
+NK_SSize64 NK_ReadFileAt(NK_Int fd, NK_Size64 offset, NK_PVoid data, NK_Size64 size)
+{
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    char *ptr = (char *)data;
+    NK_Size64 rdsize = 0;
+    while (rdsize < size) {
+        NK_Size64 chunk = size - rdsize;
+        ssize_t ret = pread(fd, ptr + rdsize, (size_t)(chunk > NK_IO_CHUNK ? NK_IO_CHUNK : chunk), (off_t)(offset + rdsize));
+        if (ret > 0) {
+            rdsize += (NK_Size64)ret;
+        } else if (ret < 0 && EINTR == errno) {
+            continue;
+        } else {
+            break;
+        }
+    }
+    return rdsize == size ? (NK_SSize64)rdsize : -1;
+#endif
+}
+
+NK_Int NK_CloseFile(NK_Int fd)
+{
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    return close(fd);
+#endif
+}
+
+NK_Int NK_OpenStream(const NK_PChar file)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    // "-" stands for standard input
+    if (0 == strcmp(file, "-")) {
+        return dup(STDIN_FILENO);
+    }
+    return open(file, O_RDONLY);
+#endif
+}
+
+NK_SSize64 NK_ReadStream(NK_Int fd, NK_PVoid data, NK_Size64 size)
+{
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    char *ptr = (char *)data;
+    NK_Size64 rdsize = 0;
+    while (rdsize < size) {
+        NK_Size64 chunk = size - rdsize;
+        ssize_t ret = read(fd, ptr + rdsize, (size_t)(chunk > NK_IO_CHUNK ? NK_IO_CHUNK : chunk));
+        if (ret > 0) {
+            rdsize += (NK_Size64)ret;
+        } else if (ret < 0 && EINTR == errno) {
+            continue;
+        } else if (ret < 0) {
+            return -1;
+        } else {
+            break;
+        }
+    }
+    return (NK_SSize64)rdsize;
+#endif
+}
+
+NK_Int NK_StatFile(const NK_PChar file, NK_FileStat *st)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != st, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    struct stat stStatBuf;
+    if (stat(file, &stStatBuf) < 0 || !S_ISREG(stStatBuf.st_mode)) {
+        return -1;
+    }
+
+    st->Dev = (NK_UInt64)stStatBuf.st_dev;
+    st->Ino = (NK_UInt64)stStatBuf.st_ino;
+    st->Size = (NK_UInt64)stStatBuf.st_size;
+    st->Mtime = (NK_UInt64)stStatBuf.st_mtim.tv_sec * 1000000000ULL + (NK_UInt64)stStatBuf.st_mtim.tv_nsec;
+    return 0;
+#endif
+}
+
+NK_Int NK_WriteFileAtomic(const NK_PChar file, const NK_PVoid data, NK_Size64 size)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != file, -1);
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    char tmp[512];
+    const char *ptr = (const char *)data;
+    NK_Size64 wrsize = 0;
+    int fd = -1;
+
+    // write a private temporary file and rename it over the target,
+    // readers either see the old file or the complete new one;
+    // mkstemp gives every writer (threads and processes alike) its own file
+    // next to the target, so concurrent stores of the same file never share one
+    NK_EXPECT_RETURN_VAL(snprintf(tmp, sizeof(tmp), "%s.XXXXXX", file) < (int)sizeof(tmp), -1);
+    fd = mkstemp(tmp);
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+    if (fchmod(fd, 0644) < 0) {
+        close(fd);
+        unlink(tmp);
+        return -1;
+    }
+
+    while (wrsize < size) {
+        NK_Size64 chunk = size - wrsize;
+        ssize_t ret = write(fd, ptr + wrsize, (size_t)(chunk > NK_IO_CHUNK ? NK_IO_CHUNK : chunk));
+        if (ret > 0) {
+            wrsize += (NK_Size64)ret;
+        } else if (ret < 0 && EINTR == errno) {
+            continue;
+        } else {
+            break;
+        }
+    }
+
+    if (close(fd) < 0 || wrsize != size || rename(tmp, file) < 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+#endif
+}
+
+NK_UInt64 NK_Hash64(const NK_PVoid data, NK_Size64 size)
+{
+    // FNV-1a
+    const NK_Byte *ptr = (const NK_Byte *)data;
+    NK_UInt64 hash = 0xcbf29ce484222325ULL;
+    NK_Size64 i;
+    for (i = 0; i < size; i++) {
+        hash ^= ptr[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+NK_UInt64 NK_HashWords(const NK_Void *data, NK_Size64 size)
+{
+    // One multiply-xorshift round per 8-byte word, loaded with memcpy so the
+    // input needs no alignment; the tail is zero-padded into a final word and
+    // the length is folded in so that padding cannot collide.
+    const NK_Byte *ptr = (const NK_Byte *)data;
+    NK_UInt64 hash = 0x9e3779b97f4a7c15ULL ^ size;
+    NK_UInt64 word;
+
+    for (; size >= 8; ptr += 8, size -= 8) {
+        memcpy(&word, ptr, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+
+    word = 0;
+    memcpy(&word, ptr, (size_t)size);
+    hash = (hash ^ word) * 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 29;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+/**
+ * 批量读取的线程池实现，工作线程轮流领取请求并同步 pread。
+ */
+#define NK_BATCH_THREADS (16)
+
+typedef struct NK_ReadBatch {
+    NK_ReadRequest *reqs;
+    NK_Int count;
+    NK_Int next;
+} NK_ReadBatch;
+
+static void *NK_ReadBatchWorker(void *arg)
+{
+    NK_ReadBatch *batch = (NK_ReadBatch *)arg;
+    for (;;) {
+        NK_Int i = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED);
+        if (i >= batch->count) break;
+        batch->reqs[i].Result = NK_ReadFileAt(batch->reqs[i].Fd, batch->reqs[i].Offset, batch->reqs[i].Data, batch->reqs[i].Size);
+    }
+    return NK_Nil;
+}
+
+static NK_Int NK_ReadBatchThreads(NK_ReadRequest *reqs, NK_Int count)
+{
+    pthread_t tids[NK_BATCH_THREADS];
+    NK_ReadBatch batch = { reqs, count, 0 };
+    NK_Int nthreads = count < NK_BATCH_THREADS ? count : NK_BATCH_THREADS;
+    NK_Int started = 0;
+    NK_Int i;
+
+    for (i = 1; i < nthreads; i++) {
+        if (0 != pthread_create(&tids[started], NK_Nil, NK_ReadBatchWorker, &batch)) break;
+        started++;
+    }
+
+    // the caller works too, so the batch completes even without extra threads
+    NK_ReadBatchWorker(&batch);
+
+    for (i = 0; i < started; i++) {
+        pthread_join(tids[i], NK_Nil);
+    }
+    return 0;
+}
+
+#if defined(NK_HAVE_IO_URING)
+
+/**
+ * 批量读取的 io_uring 实现，队列深度为 @ref NK_URING_DEPTH。
+ */
+#define NK_URING_DEPTH (256)
+
+typedef struct NK_Uring {
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ptr, *cq_ptr;
+    size_t sq_len, cq_len, sqes_len;
+    unsigned entries;
+} NK_Uring;
+
+static void NK_UringClose(NK_Uring *ring)
+{
+    if (ring->sqes && MAP_FAILED != (void *)ring->sqes) munmap(ring->sqes, ring->sqes_len);
+    if (ring->cq_ptr && MAP_FAILED != ring->cq_ptr && ring->cq_ptr != ring->sq_ptr) munmap(ring->cq_ptr, ring->cq_len);
+    if (ring->sq_ptr && MAP_FAILED != ring->sq_ptr) munmap(ring->sq_ptr, ring->sq_len);
+    if (ring->fd >= 0) close(ring->fd);
+}
+
+static NK_Int NK_UringOpen(NK_Uring *ring, unsigned entries)
+{
+    struct io_uring_params p;
+
+    memset(ring, 0, sizeof(NK_Uring));
+    memset(&p, 0, sizeof(p));
+
+    // fails with ENOSYS/EPERM where io_uring is unavailable or filtered
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (ring->fd < 0) return -1;
+
+    ring->entries = p.sq_entries;
+    ring->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_len > ring->sq_len) ring->sq_len = ring->cq_len;
+        ring->cq_len = ring->sq_len;
+    }
+
+    ring->sq_ptr = mmap(NK_Nil, ring->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == ring->sq_ptr) goto _fail_exit;
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ring->cq_ptr = mmap(NK_Nil, ring->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == ring->cq_ptr) goto _fail_exit;
+    }
+
+    ring->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NK_Nil, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (MAP_FAILED == (void *)ring->sqes) goto _fail_exit;
+
+    ring->sq_tail = (unsigned *)((char *)ring->sq_ptr + p.sq_off.tail);
+    ring->sq_mask = (unsigned *)((char *)ring->sq_ptr + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((char *)ring->sq_ptr + p.sq_off.array);
+    ring->cq_head = (unsigned *)((char *)ring->cq_ptr + p.cq_off.head);
+    ring->cq_tail = (unsigned *)((char *)ring->cq_ptr + p.cq_off.tail);
+    ring->cq_mask = (unsigned *)((char *)ring->cq_ptr + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_ptr + p.cq_off.cqes);
+    return 0;
+
+_fail_exit:
+    NK_UringClose(ring);
+    return -1;
+}
+
+// reap every completion currently in the cq ring
+static void NK_UringReap(NK_Uring *ring, NK_ReadRequest *reqs, NK_Int *inflight, NK_Int *completed)
+{
+    unsigned head = *ring->cq_head;
+
+    while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        NK_ReadRequest *req = &reqs[cqe->user_data];
+
+        if (cqe->res >= 0 && (NK_Size64)cqe->res == req->Size) {
+            req->Result = (NK_SSize64)req->Size;
+        } else {
+            // short reads and unsupported opcodes are retried synchronously
+            req->Result = NK_ReadFileAt(req->Fd, req->Offset, req->Data, req->Size);
+        }
+        head++;
+        (*inflight)--;
+        (*completed)++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// wait until the kernel owns no request, so no read can land in a buffer
+// after we return; only hard errors (the ring itself is broken) stop early
+static NK_Int NK_UringDrain(NK_Uring *ring, NK_ReadRequest *reqs, NK_Int *inflight, NK_Int *completed)
+{
+    while (*inflight > 0) {
+        if (syscall(__NR_io_uring_enter, ring->fd, 0U, 1U, IORING_ENTER_GETEVENTS, NK_Nil, 0) < 0
+            && EINTR != errno && EAGAIN != errno && EBUSY != errno) {
+            return -1;
+        }
+        NK_UringReap(ring, reqs, inflight, completed);
+    }
+    return 0;
+}
+
+// returns 0 when every read completed, -1 when the caller may redo the
+// batch, -2 when the ring broke while the kernel still owned some reads
+static NK_Int NK_ReadBatchUring(NK_ReadRequest *reqs, NK_Int count)
+{
+    NK_Uring ring;
+    NK_Int submitted = 0;
+    NK_Int completed = 0;
+    NK_Int inflight = 0;
+    NK_Int pending = 0;
+    NK_Int ret = 0;
+
+    if (NK_UringOpen(&ring, NK_URING_DEPTH) < 0) return -1;
+
+    while (completed < count) {
+
+        unsigned tail = *ring.sq_tail;
+
+        // keep the queue as deep as the ring allows; entries the kernel has
+        // not consumed yet (pending) still occupy the sq ring
+        while (submitted < count && inflight + pending < (NK_Int)ring.entries) {
+            NK_ReadRequest *req = &reqs[submitted];
+            unsigned idx = tail & *ring.sq_mask;
+            struct io_uring_sqe *sqe = &ring.sqes[idx];
+
+            // a single sqe carries a 32-bit length
+            if (req->Size > NK_IO_CHUNK) {
+                req->Result = NK_ReadFileAt(req->Fd, req->Offset, req->Data, req->Size);
+                submitted++;
+                completed++;
+                continue;
+            }
+
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = req->Fd;
+            sqe->addr = (NK_UInt64)(NK_PtrInt)req->Data;
+            sqe->len = (NK_UInt32)req->Size;
+            sqe->off = req->Offset;
+            sqe->user_data = (NK_UInt64)submitted;
+            ring.sq_array[idx] = idx;
+            tail++;
+            pending++;
+            submitted++;
+        }
+        __atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+
+        if (0 == pending && 0 == inflight) continue;
+
+        // only wait when something was already in flight before this call,
+        // otherwise a submit the kernel took none of would block forever
+        ret = (NK_Int)syscall(__NR_io_uring_enter, ring.fd, (unsigned)pending
+            , inflight > 0 ? 1U : 0U, inflight > 0 ? IORING_ENTER_GETEVENTS : 0U, NK_Nil, 0);
+        if (ret < 0) {
+            // EAGAIN/EBUSY: the kernel is short of resources or the cq ring
+            // is full, reaping completions makes room
+            if ((EINTR == errno || EAGAIN == errno || EBUSY == errno) && inflight > 0) {
+                NK_UringReap(&ring, reqs, &inflight, &completed);
+                continue;
+            }
+            if (EINTR == errno) continue;
+            break;
+        }
+
+        // the return value is the number of sqes the kernel actually took
+        inflight += ret;
+        pending -= ret;
+        if (0 == ret && 0 == inflight) {
+            break;
+        }
+
+        NK_UringReap(&ring, reqs, &inflight, &completed);
+    }
+
+    // on failure the caller redoes the whole batch into the same buffers,
+    // so first wait for the reads the kernel still owns
+    if (completed < count && NK_UringDrain(&ring, reqs, &inflight, &completed) < 0) {
+        NK_UringClose(&ring);
+        return -2;
+    }
+
+    NK_UringClose(&ring);
+
+    return completed < count ? -1 : 0;
+}
+
+#endif
+
+NK_Int NK_ReadFileBatch(NK_ReadRequest *reqs, NK_Int count)
+{
+    NK_Int i;
+
+    NK_EXPECT_RETURN_VAL(NK_Nil != reqs, -1);
+    NK_EXPECT_RETURN_VAL(count >= 0, -1);
+
+    for (i = 0; i < count; i++) {
+        reqs[i].Result = -1;
+    }
+
+#if defined(NK_HAVE_IO_URING)
+    NK_Int ret = NK_ReadBatchUring(reqs, count);
+    if (0 == ret) {
+        return 0;
+    }
+    // reads may still be in flight, the buffers must not be reused
+    if (-2 == ret) {
+        return -1;
+    }
+#endif
+
+    return NK_ReadBatchThreads(reqs, count);
+}
+
+NK_Int NK_AdviseBuffer(NK_PVoid data, NK_Size64 offset, NK_Size64 size, NK_Int advice)
+{
+    NK_EXPECT_RETURN_VAL(NK_Nil != data, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    static const int advices[] = {
+        MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED,
+    };
+    NK_Size64 page = (NK_Size64)sysconf(_SC_PAGESIZE);
+    NK_Size64 begin = 0;
+    NK_Size64 end = 0;
+
+    NK_EXPECT_RETURN_VAL(advice >= 0 && advice < (NK_Int)(sizeof(advices) / sizeof(advices[0])), -1);
+
+    // madvise works on whole pages, the mapping itself is page aligned.
+    // DONTNEED must not touch pages shared with neighbouring data,
+    // so it shrinks to the inner pages while other hints round outwards.
+    if (NK_ADVICE_DONTNEED == advice) {
+        begin = (offset + page - 1) & ~(page - 1);
+        end = (offset + size) & ~(page - 1);
+    } else {
+        begin = offset & ~(page - 1);
+        end = (offset + size + page - 1) & ~(page - 1);
+    }
+    if (end <= begin) return 0;
+
+    return madvise((char *)data + begin, (size_t)(end - begin), advices[advice]);
+#endif
+}
+
+NK_Int NK_AdviseFile(NK_Int fd, NK_Size64 offset, NK_Size64 size, NK_Int advice)
+{
+    NK_EXPECT_RETURN_VAL(fd >= 0, -1);
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    static const int advices[] = {
+        POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM, POSIX_FADV_WILLNEED, POSIX_FADV_DONTNEED,
+    };
+
+    NK_EXPECT_RETURN_VAL(advice >= 0 && advice < (NK_Int)(sizeof(advices) / sizeof(advices[0])), -1);
+
+    return posix_fadvise(fd, (off_t)offset, (off_t)size, advices[advice]);
+#endif
+}
+
+NK_Int NK_GetFaults(NK_UInt64 *major, NK_UInt64 *minor)
+{
+#if defined(_WIN32)
+    #error "error : no implemented!"
+    return -1;
+#else
+    struct rusage usage;
+    NK_EXPECT_RETURN_VAL(0 == getrusage(RUSAGE_SELF, &usage), -1);
+    if (major) *major = (NK_UInt64)usage.ru_majflt;
+    if (minor) *minor = (NK_UInt64)usage.ru_minflt;
+    return 0;
+#endif
+}
+
+/**
+ * 字节序转换支持的最大结构体长度与重排周期。\n
+ * 字节重排按 16 字节块进行，结构体长度与 32 的最小公倍数为一个周期，\n
+ * 周期内每个块对应一个重排掩码，AVX2 每次处理相邻的两个块。
+ */
+#define NK_SWAP_MAX_SIZE    (64)
+#define NK_SWAP_MAX_MASKS   (32)
+
+#if defined(NK_HAVE_SHUFFLE)
+
+__attribute__((target("avx2")))
+static NK_Size64 NK_SwapAvx2(NK_PByte dst, const NK_Byte *src, NK_Size64 size, NK_Byte (*masks)[16], NK_Int nmasks)
+{
+    __m256i mask[NK_SWAP_MAX_MASKS / 2];
+    NK_Size64 period = (NK_Size64)nmasks * 16;
+    NK_Size64 done = 0;
+    NK_Int i;
+
+    for (i = 0; i < nmasks / 2; i++) {
+        mask[i] = _mm256_loadu_si256((const __m256i *)masks[i * 2]);
+    }
+
+    for (; done + period <= size; done += period) {
+        for (i = 0; i < nmasks / 2; i++) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + done + i * 32));
+            _mm256_storeu_si256((__m256i *)(dst + done + i * 32), _mm256_shuffle_epi8(v, mask[i]));
+        }
+    }
+    return done;
+}
+
+__attribute__((target("ssse3")))
+static NK_Size64 NK_SwapSsse3(NK_PByte dst, const NK_Byte *src, NK_Size64 size, NK_Byte (*masks)[16], NK_Int nmasks)
+{
+    __m128i mask[NK_SWAP_MAX_MASKS];
+    NK_Size64 period = (NK_Size64)nmasks * 16;
+    NK_Size64 done = 0;
+    NK_Int i;
+
+    for (i = 0; i < nmasks; i++) {
+        mask[i] = _mm_loadu_si128((const __m128i *)masks[i]);
+    }
+
+    for (; done + period <= size; done += period) {
+        for (i = 0; i < nmasks; i++) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + done + i * 16));
+            _mm_storeu_si128((__m128i *)(dst + done + i * 16), _mm_shuffle_epi8(v, mask[i]));
+        }
+    }
+    return done;
+}
+
+/**
+ * 按结构体的字节置换生成一个周期的重排掩码，\n
+ * 有字段跨越 16 字节块时无法块内重排，返回 -1。
+ */
+static NK_Int NK_SwapMasks(const NK_Byte *perm, NK_Size64 entsize, NK_Byte (*masks)[16], NK_Int *nmasks)
+{
+    NK_Size64 period = entsize;
+    NK_Size64 i;
+
+    while (period % 32) period += entsize;
+    NK_EXPECT_RETURN_VAL(period / 16 <= NK_SWAP_MAX_MASKS, -1);
+
+    for (i = 0; i < period; i++) {
+        NK_Size64 from = i - i % entsize + perm[i % entsize];
+        // the source byte has to stay within the 16-byte lane of its destination
+        NK_EXPECT_RETURN_VAL(from / 16 == i / 16, -1);
+        masks[i / 16][i % 16] = (NK_Byte)(from % 16);
+    }
+    *nmasks = (NK_Int)(period / 16);
+    return 0;
+}
+
+#endif
+
+NK_Int NK_SwapArray(NK_PVoid dst, const NK_Void *src, NK_Size64 count, const NK_Byte *fields, NK_Int nfields)
+{
+    NK_Byte perm[NK_SWAP_MAX_SIZE];
+    NK_Size64 entsize = 0;
+    NK_Size64 done = 0;
+    NK_Size64 size = 0;
+    NK_Int i;
+
+    NK_EXPECT_RETURN_VAL(NK_Nil != dst && NK_Nil != src && NK_Nil != fields, -1);
+
+    // byte permutation of one struct: destination byte i comes from source byte perm[i]
+    for (i = 0; i < nfields; i++) {
+        NK_Size64 j;
+        NK_Boolean swap = (2 == fields[i] || 4 == fields[i] || 8 == fields[i]);
+        NK_EXPECT_RETURN_VAL(entsize + fields[i] <= NK_SWAP_MAX_SIZE, -1);
+        for (j = 0; j < fields[i]; j++) {
+            perm[entsize + j] = (NK_Byte)(entsize + (swap ? fields[i] - 1 - j : j));
+        }
+        entsize += fields[i];
+    }
+    NK_EXPECT_RETURN_VAL(entsize > 0 && count <= (NK_Size64)-1 / entsize, -1);
+    size = count * entsize;
+
+#if defined(NK_HAVE_SHUFFLE)
+    {
+        NK_Byte masks[NK_SWAP_MAX_MASKS][16];
+        NK_Int nmasks = 0;
+
+        // whole periods are shuffled, the remaining structs go through the scalar path
+        if (0 == NK_SwapMasks(perm, entsize, masks, &nmasks)) {
+            if (__builtin_cpu_supports("avx2"))
+                done = NK_SwapAvx2((NK_PByte)dst, (const NK_Byte *)src, size, masks, nmasks);
+            else if (__builtin_cpu_supports("ssse3"))
+                done = NK_SwapSsse3((NK_PByte)dst, (const NK_Byte *)src, size, masks, nmasks);
+        }
+    }
+#endif
+
+    for (; done < size; done += entsize) {
+        NK_PByte d = (NK_PByte)dst + done;
+        const NK_Byte *s = (const NK_Byte *)src + done;
+        NK_Size64 off = 0;
+        for (i = 0; i < nfields; i++) {
+            switch (fields[i]) {
+            case 2: { NK_UInt16 v; memcpy(&v, s + off, 2); v = __builtin_bswap16(v); memcpy(d + off, &v, 2); break; }
+            case 4: { NK_UInt32 v; memcpy(&v, s + off, 4); v = __builtin_bswap32(v); memcpy(d + off, &v, 4); break; }
+            case 8: { NK_UInt64 v; memcpy(&v, s + off, 8); v = __builtin_bswap64(v); memcpy(d + off, &v, 8); break; }
+            default: memmove(d + off, s + off, fields[i]); break;
+            }
+            off += fields[i];
+        }
+    }
+    return 0;
+}
@@ -6,9 +6,153 @@
 
 NK_CPP_EXTERN_BEGIN
 
-NK_API NK_Int
+/**
+ * 文件标识，用于判断文件是否被修改。
+ */
+typedef struct NK_FileStat {
+
+    NK_UInt64 Dev;
+
+    NK_UInt64 Ino;
+
+    NK_UInt64 Size;
+
+    /// 修改时间，纳秒
+    NK_UInt64 Mtime;
+
+} NK_FileStat;
+
+NK_LOCAL NK_SSize64
 NK_ReadFile2Buffer(const NK_PChar file, NK_PChar *data);
 
+/**
+ * 只读映射文件，返回映射长度，失败返回 -1。
+ * 仅普通文件可映射，映射内容由 @ref NK_UnmapBuffer 释放。
+ */
+NK_LOCAL NK_SSize64
+NK_MapFile2Buffer(const NK_PChar file, NK_PChar *data);
+
+NK_LOCAL NK_Int
+NK_UnmapBuffer(NK_PChar data, NK_Size64 size);
+
+/**
+ * 以只读方式打开普通文件，返回文件描述符，失败返回 -1。
+ * @ref size 非空时输出文件长度。
+ */
+NK_LOCAL NK_Int
+NK_OpenFile(const NK_PChar file, NK_Size64 *size);
+
+/**
+ * 从文件 @ref offset 处读取 @ref size 字节，不改变文件位置。
+ * 完整读取返回 @ref size，否则返回 -1。
+ */
+NK_LOCAL NK_SSize64
+NK_ReadFileAt(NK_Int fd, NK_Size64 offset, NK_PVoid data, NK_Size64 size);
+
+NK_LOCAL NK_Int
+NK_CloseFile(NK_Int fd);
+
+/**
+ * 以顺序读方式打开文件、管道或设备，"-" 表示标准输入。
+ * 返回文件描述符，失败返回 -1。
+ * 流不可回读，调用者需自行暂存之后还要访问的内容，如解析器暂存段表之前的数据，见 @ref NK_Parse_Create()。
+ */
+NK_LOCAL NK_Int
+NK_OpenStream(const NK_PChar file);
+
+/**
+ * 从当前位置顺序读取至多 @ref size 字节，返回实际读取的字节数，
+ * 小于 @ref size 表示已到达流末尾，出错返回 -1。
+ */
+NK_LOCAL NK_SSize64
+NK_ReadStream(NK_Int fd, NK_PVoid data, NK_Size64 size);
+
+/**
+ * 获取普通文件的标识，非普通文件返回 -1。
+ */
+NK_LOCAL NK_Int
+NK_StatFile(const NK_PChar file, NK_FileStat *st);
+
+/**
+ * 写入临时文件后重命名为 @ref file，读者不会看到写了一半的文件。
+ */
+NK_LOCAL NK_Int
+NK_WriteFileAtomic(const NK_PChar file, const NK_PVoid data, NK_Size64 size);
+
+/**
+ * 64 位 FNV-1a 散列。
+ */
+NK_LOCAL NK_UInt64
+NK_Hash64(const NK_PVoid data, NK_Size64 size);
+
+/**
+ * 按 8 字节一组计算的 64 位散列（SWAR），每组一次乘法，比逐字节的 @ref NK_Hash64() 快数倍。\n
+ * 结果与本机字节序相关，只用于内存中的散列表，不得持久化。
+ */
+NK_LOCAL NK_UInt64
+NK_HashWords(const NK_Void *data, NK_Size64 size);
+
+/**
+ * 访问模式提示，见 @ref NK_AdviseBuffer()、@ref NK_AdviseFile()。
+ */
+#define NK_ADVICE_NORMAL        (0)
+#define NK_ADVICE_SEQUENTIAL    (1)
+#define NK_ADVICE_RANDOM        (2)
+#define NK_ADVICE_WILLNEED      (3)
+#define NK_ADVICE_DONTNEED      (4)
+
+/**
+ * 对映射内存 [@ref offset, @ref offset + @ref size) 发出 madvise 提示，\n
+ * @ref data 为页对齐的映射起始地址。
+ */
+NK_LOCAL NK_Int
+NK_AdviseBuffer(NK_PVoid data, NK_Size64 offset, NK_Size64 size, NK_Int advice);
+
+/**
+ * 对文件区间发出 posix_fadvise 提示，@ref size 为 0 表示到文件末尾。
+ */
+NK_LOCAL NK_Int
+NK_AdviseFile(NK_Int fd, NK_Size64 offset, NK_Size64 size, NK_Int advice);
+
+/**
+ * 获取进程累计的主/次缺页次数。
+ */
+NK_LOCAL NK_Int
+NK_GetFaults(NK_UInt64 *major, NK_UInt64 *minor);
+
+/**
+ * 批量读取请求。
+ */
+typedef struct NK_ReadRequest {
+
+    NK_Int Fd;
+
+    NK_Size64 Offset;
+
+    NK_Size64 Size;
+
+    NK_PVoid Data;
+
+    /// 完整读取时为 @ref Size，否则为 -1
+    NK_SSize64 Result;
+
+} NK_ReadRequest;
+
+/**
+ * 批量并发读取，结果写入各请求的 Result。\n
+ * Linux 上通过 io_uring 一次提交多个请求，不可用时退回到线程池 pread。
+ */
+NK_LOCAL NK_Int
+NK_ReadFileBatch(NK_ReadRequest *reqs, NK_Int count);
+
+/**
+ * 转换结构体数组的字节序，@ref fields 依次为结构体各字段的长度（共 @ref nfields 个，无填充），\n
+ * 长度为 2、4、8 的字段翻转字节，其余长度（如 e_ident）原样拷贝。\n
+ * @ref dst 可以与 @ref src 相同。x86 上按 CPU 支持选用 AVX2/SSSE3 字节重排，否则逐字段转换。
+ */
+NK_LOCAL NK_Int
+NK_SwapArray(NK_PVoid dst, const NK_Void *src, NK_Size64 count, const NK_Byte *fields, NK_Int nfields);
+
 NK_CPP_EXTERN_END
 #endif /* __NK_UTILS_H__ */
 